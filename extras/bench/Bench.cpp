@@ -0,0 +1,116 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <stdarg.h>
+
+const sp_len_t benchPayloadSizes[] = {0, 1, 8,
+#if SP_MAX_DATA_LEN > 32
+		32,
+#endif
+#if SP_MAX_DATA_LEN > 64
+		64,
+#endif
+		SP_MAX_DATA_LEN};
+const uint8_t benchPayloadSizesCount = sizeof(benchPayloadSizes) / sizeof(benchPayloadSizes[0]);
+
+bool benchQuick = false;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long benchIterations(size_t bytesPerIteration) {
+	unsigned long totalBytes = benchQuick ? 1UL << 18 : 1UL << 24;
+	unsigned long ret = totalBytes / (bytesPerIteration + 1);
+	return ret < 16 ? 16 : ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchSection(const char *title) {
+	printf("\n== %s\n", title);
+	printf("%-28s %8s %14s %14s %12s\n", "benchmark", "payload", "packets/s", "bytes/s", "ns/packet");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchReport(const char *name, size_t payload, unsigned long packets, unsigned long bytes, double ns) {
+	double seconds = ns / 1e9;
+	printf("%-28s %8zu %14.0f %14.0f %12.1f\n", name, payload,
+			packets / seconds, bytes / seconds, ns / packets);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchNote(const char *fmt, ...) {
+	va_list args;
+	va_start(args, fmt);
+	vprintf(fmt, args);
+	va_end(args);
+	printf("\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchCheck(bool condition, const char *what) {
+	if (!condition) {
+		fprintf(stderr, "CHECK FAILED: %s\n", what);
+		exit(EXIT_FAILURE);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchFillPacket(SimplePacketBase &packet, sp_len_t len, uint8_t seed) {
+	uint8_t data[SP_MAX_DATA_LEN];
+	benchCheck(len <= SP_MAX_DATA_LEN, "payload within SP_MAX_DATA_LEN");
+	for (sp_len_t i = 0; i < len; ++i) {
+		data[i] = (uint8_t) (i * 31 + seed);
+	}
+	packet.setData(data, len);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char **argv) {
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--quick") == 0) {
+			benchQuick = true;
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--quick]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	benchCore();
+	benchCRC();
+	benchReceiver();
+	benchResync();
+	benchTimeout();
+	benchTxQueue();
+	benchBatch();
+	benchMessage();
+	benchWire();
+	benchVarint();
+	benchCompress();
+	benchLongFrame();
+	benchFragment();
+	benchReliable();
+	benchScheduler();
+	benchAddressFilter();
+	benchDispatcher();
+	benchRouter();
+	benchStats();
+	benchPacketSize();
+	benchPool();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __Bench_H__
+#define __Bench_H__
+
+#include <Arduino.h>
+#include <SimpleComm.h>
+
+#include <chrono>
+
+#include "MockStream.h"
+
+// Payload sizes every packet benchmark is run with
+extern const sp_len_t benchPayloadSizes[];
+extern const uint8_t benchPayloadSizesCount;
+
+// Reduced iteration counts (--quick)
+extern bool benchQuick;
+
+class BenchTimer {
+public:
+	BenchTimer() { start(); }
+
+	void start() { _start = std::chrono::steady_clock::now(); }
+	double elapsedNs() const {
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - _start).count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point _start;
+};
+
+// Number of iterations needed to move roughly the same amount of bytes for
+// every payload size
+unsigned long benchIterations(size_t bytesPerIteration);
+
+// Prints the table header of a benchmark section
+void benchSection(const char *title);
+
+// Prints one result row: packets/sec, bytes/sec and ns/packet
+void benchReport(const char *name, size_t payload, unsigned long packets, unsigned long bytes, double ns);
+
+// Prints a free-form result row
+void benchNote(const char *fmt, ...);
+
+// Aborts the benchmark run when a self-check fails
+void benchCheck(bool condition, const char *what);
+
+// Payload length of a self-check, cut to SP_MAX_DATA_LEN
+#define BENCH_LEN(len) ((len) < SP_MAX_DATA_LEN ? (len) : SP_MAX_DATA_LEN)
+
+// Fills a packet with a deterministic payload of the given length
+void benchFillPacket(SimplePacketBase &packet, sp_len_t len, uint8_t seed = 0);
+
+// Benchmark sections
+void benchCore();
+void benchCRC();
+void benchReceiver();
+void benchResync();
+void benchTimeout();
+void benchTxQueue();
+void benchBatch();
+void benchMessage();
+void benchWire();
+void benchVarint();
+void benchCompress();
+void benchLongFrame();
+void benchFragment();
+void benchReliable();
+void benchScheduler();
+void benchAddressFilter();
+void benchDispatcher();
+void benchRouter();
+void benchStats();
+void benchPacketSize();
+void benchPool();
+
+#endif // __Bench_H__
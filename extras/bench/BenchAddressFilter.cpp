@@ -0,0 +1,160 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+#include "SimLine.h"
+
+// Slaves on the simulated bus, one of them receiving
+#define BUS_SLAVES 8
+#define BUS_FRAMES 64
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static size_t buildFrames(MockStream &bus, const uint8_t *destinations, uint8_t count, sp_len_t len) {
+	// Frame i goes to destinations[i] with type i
+	SimpleCommLink sender(bus, 0x7F);
+	SimplePacket tx;
+	for (uint8_t i = 0; i < count; ++i) {
+		benchFillPacket(tx, len, i);
+		sender.send(tx, destinations[i], i);
+	}
+	return bus.available();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkFilter(bool bulkRead, bool early, bool byteByByte) {
+	static const uint8_t destinations[] = {1, 2, 3, 0, 0x12, 2, 0x21, 4, 2};
+	static const sp_len_t lengths[] = {0, BENCH_LEN(20), SP_MAX_DATA_LEN};
+
+	for (uint8_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); ++l) {
+		MockStream bus(sizeof(destinations) * SP_BUFFER_SIZE);
+		size_t total = buildFrames(bus, destinations, sizeof(destinations), lengths[l]);
+		uint8_t bytes[sizeof(destinations) * SP_BUFFER_SIZE];
+		bus.readBytes(bytes, total);
+
+		// Address 2, then the group 0x10 to 0x1F
+		for (uint8_t g = 0; g < 2; ++g) {
+			MockStream stream(sizeof(bytes));
+			SimpleCommLink link(stream, g ? 0x10 : 2);
+			link.setAddressMask(g ? 0xF0 : 0xFF);
+			link.setBulkRead(bulkRead);
+			link.setEarlyFilter(early);
+			SimplePacket rx;
+
+			uint16_t types = 0;
+			uint8_t received = 0;
+			for (size_t i = 0; i < total; ) {
+				size_t chunk = byteByByte ? 1 : total;
+				stream.write(bytes + i, chunk);
+				i += chunk;
+				while (link.receive(rx)) {
+					types |= 1 << rx.getType();
+					received += rx.getDataLength() == lengths[l] && rx.getSource() == 0x7F;
+				}
+			}
+
+			// Broadcasts are always accepted
+			uint16_t expected = g ? (1 << 3 | 1 << 4) : (1 << 1 | 1 << 3 | 1 << 5 | 1 << 8);
+			uint8_t count = g ? 2 : 4;
+			benchCheck(types == expected && received == count, "only frames for the link address are received");
+			benchCheck(link.getStats().addressRejects == sizeof(destinations) - count
+					&& link.getStats().bytesDropped == 0 && link.getStats().crcErrors == 0, "foreign frames are rejected without errors");
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkSkipTimeout(bool bulkRead) {
+	static const uint8_t destinations[] = {3, 2};
+	MockStream bus;
+	size_t total = buildFrames(bus, destinations, 2, BENCH_LEN(30));
+	uint8_t bytes[2 * SP_BUFFER_SIZE];
+	bus.readBytes(bytes, total);
+	size_t first = total / 2;
+
+	MockStream stream;
+	SimpleCommLink link(stream, 2);
+	link.setBulkRead(bulkRead);
+	link.setEarlyFilter(true);
+	link.setClock(simClock);
+	link.setTimeouts(1000);
+	SimplePacket rx;
+
+	// The foreign frame is cut: its skip ends on the gap, not inside the next frame
+	simNow = 0;
+	stream.write(bytes, first / 2);
+	benchCheck(!link.receive(rx), "cut foreign frame");
+	simNow += 5000;
+	stream.write(bytes + first, total - first);
+	benchCheck(link.receive(rx) && rx.getType() == 1, "a skip ends on a receive timeout");
+	benchCheck(link.getStats().timeouts == 1 && link.getStats().addressRejects == 1, "skip timeout statistics");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchBus(sp_len_t len, bool bulkRead, bool early) {
+	// Frames for every slave in turn, as a master polling the bus sends them
+	uint8_t destinations[BUS_FRAMES];
+	for (uint8_t i = 0; i < BUS_FRAMES; ++i) {
+		destinations[i] = 1 + i % BUS_SLAVES;
+	}
+	MockStream bus(BUS_FRAMES * SP_BUFFER_SIZE);
+	size_t total = buildFrames(bus, destinations, BUS_FRAMES, len);
+	static uint8_t bytes[BUS_FRAMES * SP_BUFFER_SIZE];
+	bus.readBytes(bytes, total);
+
+	MockStream stream(BUS_FRAMES * SP_BUFFER_SIZE);
+	SimpleCommLink link(stream, 1);
+	link.setBulkRead(bulkRead);
+	link.setEarlyFilter(early);
+	SimplePacket rx;
+
+	unsigned long iterations = benchIterations(total);
+	unsigned long received = 0;
+	double ns = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		stream.clear();
+		stream.write(bytes, total);
+
+		BenchTimer timer;
+		while (link.receive(rx)) {
+			++received;
+		}
+		ns += timer.elapsedNs();
+	}
+
+	benchCheck(received == iterations * BUS_FRAMES / BUS_SLAVES, "own frames are received on a busy bus");
+	char name[32];
+	snprintf(name, sizeof(name), "1 of 8 slaves%s%s", bulkRead ? ", bulk" : "", early ? ", early" : "");
+	benchReport(name, len, received, iterations * total, ns);
+	benchNote("%-28s %8s ns per bus byte: %.2f", "", "", ns / (iterations * total));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchAddressFilter() {
+	for (uint8_t mode = 0; mode < 8; ++mode) {
+		checkFilter(mode & 1, mode & 2, mode & 4);
+	}
+	checkSkipTimeout(false);
+	checkSkipTimeout(true);
+
+	benchSection("Address filtering on a busy bus");
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchBus(benchPayloadSizes[i], false, false);
+		benchBus(benchPayloadSizes[i], false, true);
+		benchBus(benchPayloadSizes[i], true, false);
+		benchBus(benchPayloadSizes[i], true, true);
+	}
+}
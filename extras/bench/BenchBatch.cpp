@@ -0,0 +1,111 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommBatch.h>
+
+// Payloads too long for a 1-byte LEN go in long frames
+#define FRAME_LEN(dlen) (SP_SYN_LEN + ((dlen) > SP_SHORT_MAX_DATA_LEN ? SP_LEN_EXT_LEN : 0) + SP_LEN_LEN + SP_HDR_LEN + (dlen) + SP_CRC_LEN)
+
+// Cost model of a write to a W5500 socket: a fixed cost per SPI
+// transaction (command phase, TX pointer update, SEND command) plus the
+// bytes clocked at 14 MHz
+#define WRITE_COST_NS 12000
+#define BYTE_COST_NS 570
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkBatch() {
+	MockStream stream;
+	SimpleCommLink link(stream, 3);
+	SimpleCommLink receiver(stream, 4);
+	SimpleCommBatchBuffer<3 * FRAME_LEN(8)> batch(link);
+	SimplePacket tx;
+	SimplePacket rx;
+
+	for (uint8_t i = 0; i < 3; ++i) {
+		benchFillPacket(tx, 8, i);
+		benchCheck(batch.add(tx, 4, i), "batch accepts a frame");
+	}
+	benchCheck(!batch.add(tx, 4) && batch.count() == 3, "batch rejects a frame that doesn't fit");
+	benchCheck(stream.available() == 0, "nothing written before flush");
+	benchCheck(batch.flush() && stream.writeCalls == 1 && batch.count() == 0, "one write per batch");
+	for (uint8_t i = 0; i < 3; ++i) {
+		benchCheck(receiver.receive(rx) && rx.getType() == i && rx.getSource() == 3 && rx.getDestination() == 4, "batched frames");
+	}
+	benchCheck(link.getStats().packetsSent == 3, "batched frames are counted");
+
+	// A packet holding a partial frame is encoded in place: the frame is dropped
+	benchFillPacket(tx, 8, 5);
+	receiver.send(tx, 3, 0x20);
+	uint8_t frame[SP_BUFFER_SIZE];
+	size_t frameLen = stream.readBytes(frame, sizeof(frame));
+	stream.write(frame, 5);
+	benchCheck(!link.receive(tx), "partial frame");
+	benchCheck(batch.add(tx, 4, 0x21), "batch accepts the packet");
+	stream.write(frame + 5, frameLen - 5);
+	benchCheck(!link.receive(rx) && link.getStats().crcErrors == 0, "partial frame dropped by add");
+	batch.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchSend(sp_len_t len, uint8_t batchSize) {
+	MockStream stream(1 << 16);
+	SimpleCommLink link(stream);
+	SimpleCommBatchBuffer<1024> batch(link);
+	SimplePacket packet;
+	benchFillPacket(packet, len);
+
+	unsigned long iterations = benchIterations(FRAME_LEN(len) * batchSize);
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		if (batchSize == 1) {
+			link.send(packet, 1, 0x10);
+		}
+		else {
+			for (uint8_t j = 0; j < batchSize; ++j) {
+				batch.add(packet, 1, 0x10);
+			}
+			batch.flush();
+		}
+		stream.clear();
+	}
+	double ns = timer.elapsedNs();
+
+	unsigned long packets = iterations * batchSize;
+	benchCheck(link.getStats().packetsSent == packets, "every packet sent");
+	char name[32];
+	snprintf(name, sizeof(name), batchSize == 1 ? "send" : "batch of %u", batchSize);
+	benchReport(name, len, packets, packets * FRAME_LEN(len), ns);
+
+	double modelled = (double) stream.writeCalls * WRITE_COST_NS + (double) stream.bytesWritten * BYTE_COST_NS;
+	benchNote("%-28s %8s writes/packet %.3f, W5500 model %.0f packets/s", "", "",
+			(double) stream.writeCalls / packets, packets / (modelled / 1e9));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchBatch() {
+	checkBatch();
+
+	benchSection("Batched send");
+	static const uint8_t sizes[] = {1, 8, BENCH_LEN(32)};
+	for (uint8_t i = 0; i < sizeof(sizes); ++i) {
+		for (uint8_t j = 0; j < 3; ++j) {
+			benchSend(sizes[i], j == 0 ? 1 : j == 1 ? 4 : 16);
+		}
+	}
+}
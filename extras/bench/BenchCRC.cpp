@@ -0,0 +1,152 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+typedef uint16_t (*CRCFunction)(const uint8_t *buffer, size_t len);
+
+static uint16_t runSum(const uint8_t *buffer, size_t len) {
+	return SimpleCRC::sum(0, buffer, len);
+}
+
+static uint16_t runCRC8(const uint8_t *buffer, size_t len) {
+	return SimpleCRC::crc8(0, buffer, len);
+}
+
+static uint16_t runCRC8Slice4(const uint8_t *buffer, size_t len) {
+	return SimpleCRC::crc8Slice4(0, buffer, len);
+}
+
+static uint16_t runCRC16(const uint8_t *buffer, size_t len) {
+	return SimpleCRC::crc16Modbus(0xFFFF, buffer, len);
+}
+
+static uint16_t runCRC16Slice4(const uint8_t *buffer, size_t len) {
+	return SimpleCRC::crc16ModbusSlice4(0xFFFF, buffer, len);
+}
+
+static const struct {
+	const char *name;
+	CRCFunction function;
+	uint16_t check;
+} algorithms[] = {
+	{"sum", runSum, 0xDD},
+	{"crc-8", runCRC8, 0xF4},
+	{"crc-8 slice-by-4", runCRC8Slice4, 0xF4},
+	{"crc-16/modbus", runCRC16, 0x4B37},
+	{"crc-16/modbus slice-by-4", runCRC16Slice4, 0x4B37},
+};
+static const uint8_t algorithmsCount = sizeof(algorithms) / sizeof(algorithms[0]);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkAlgorithms() {
+	static const uint8_t check[] = "123456789";
+	for (uint8_t a = 0; a < algorithmsCount; ++a) {
+		benchCheck(algorithms[a].function(check, 9) == algorithms[a].check, algorithms[a].name);
+	}
+
+	// Slice-by-4 has to match the byte-wise version for every length and alignment
+	uint8_t buffer[SP_HDR_LEN + SP_MAX_DATA_LEN + 3];
+	for (uint16_t i = 0; i < sizeof(buffer); ++i) {
+		buffer[i] = (uint8_t) (i * 73 + 11);
+	}
+	for (uint8_t offset = 0; offset < 4; ++offset) {
+		for (sp_len_t len = 0; len <= SP_HDR_LEN + SP_MAX_DATA_LEN; ++len) {
+			benchCheck(runCRC8(buffer + offset, len) == runCRC8Slice4(buffer + offset, len), "crc-8 slice-by-4");
+			benchCheck(runCRC16(buffer + offset, len) == runCRC16Slice4(buffer + offset, len), "crc-16 slice-by-4");
+		}
+	}
+
+	// Incremental updates are equivalent to a single pass
+	sp_crc_t crc = SP_CRC_INIT;
+	crc = SimpleCRC::update(crc, buffer, 5);
+	crc = SimpleCRC::update(crc, buffer + 5, sizeof(buffer) - 5);
+	benchCheck(crc == SimpleCRC::calc(buffer, sizeof(buffer)), "incremental update");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchAlgorithm(uint8_t a, sp_len_t len) {
+	uint8_t buffer[SP_HDR_LEN + SP_MAX_DATA_LEN];
+	for (uint16_t i = 0; i < sizeof(buffer); ++i) {
+		buffer[i] = (uint8_t) i;
+	}
+
+	unsigned long iterations = benchIterations(SP_HDR_LEN + len);
+	volatile uint16_t sink = 0;
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		buffer[0] = (uint8_t) i;
+		sink = sink + algorithms[a].function(buffer, SP_HDR_LEN + len);
+	}
+	double ns = timer.elapsedNs();
+
+	benchReport(algorithms[a].name, len, iterations, iterations * (SP_HDR_LEN + len), ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchDetection(uint8_t a) {
+	// Corrupts random frames of 16 bytes and counts how many pass the check
+	const unsigned long trials = benchQuick ? 20000 : 200000;
+	uint8_t buffer[16];
+	unsigned long swaps = 0;
+	unsigned long bursts = 0;
+	uint32_t seed = 12345;
+
+	for (unsigned long t = 0; t < trials; ++t) {
+		for (size_t i = 0; i < sizeof(buffer); ++i) {
+			seed = seed * 1103515245 + 12345;
+			buffer[i] = seed >> 16;
+		}
+		uint16_t good = algorithms[a].function(buffer, sizeof(buffer));
+		uint8_t pos = (seed >> 8) % (sizeof(buffer) - 1);
+
+		// Adjacent bytes swapped
+		if (buffer[pos] != buffer[pos + 1]) {
+			uint8_t tmp = buffer[pos];
+			buffer[pos] = buffer[pos + 1];
+			buffer[pos + 1] = tmp;
+			swaps += algorithms[a].function(buffer, sizeof(buffer)) == good;
+			buffer[pos + 1] = buffer[pos];
+			buffer[pos] = tmp;
+		}
+
+		// Burst error of up to 16 bits
+		seed = seed * 1103515245 + 12345;
+		uint16_t burst = (seed >> 16) | 0x8001;
+		buffer[pos] ^= burst >> 8;
+		buffer[pos + 1] ^= burst & 0xFF;
+		bursts += algorithms[a].function(buffer, sizeof(buffer)) == good;
+	}
+
+	benchNote("%-28s undetected swaps %lu/%lu, undetected 16-bit bursts %lu/%lu",
+			algorithms[a].name, swaps, trials, bursts, trials);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchCRC() {
+	checkAlgorithms();
+
+	benchSection("Integrity checks");
+	for (uint8_t a = 0; a < algorithmsCount; ++a) {
+		for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+			benchAlgorithm(a, benchPayloadSizes[i]);
+		}
+	}
+	for (uint8_t a = 0; a < algorithmsCount; ++a) {
+		benchDetection(a);
+	}
+}
@@ -0,0 +1,201 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleLZ.h>
+
+#define FRAME_OVERHEAD (SP_SYN_LEN + SP_LEN_LEN + SP_HDR_LEN + SP_CRC_LEN)
+
+// 19200 bps, 8N1
+#define BYTE_TIME_US 521
+
+enum Payload {
+	TEXT,
+	REGISTERS,
+	REPEATED,
+	RANDOM,
+	PAYLOADS,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static sp_len_t makePayload(Payload kind, uint8_t *buffer, uint32_t seed) {
+	sp_len_t len = SP_MAX_DATA_LEN;
+	if (kind == TEXT) {
+		// Status dump of a controller, at least one record even if it has to be cut
+		len = 0;
+		for (uint8_t i = 0; len == 0 || len + 24 < SP_MAX_DATA_LEN; ++i) {
+			len += snprintf((char*) buffer + len, SP_MAX_DATA_LEN - len, "AI%u=%4u;Q%u=%u;", i, (unsigned) (seed * 7 + i * 131) % 1024, i, (unsigned) (seed >> (i % 32)) & 1);
+		}
+		if (len >= SP_MAX_DATA_LEN) {
+			len = SP_MAX_DATA_LEN - 1;
+		}
+	}
+	else if (kind == REGISTERS) {
+		// Block of holding registers, slowly varying around a few setpoints
+		for (sp_len_t i = 0; i < SP_MAX_DATA_LEN / 2; ++i) {
+			uint16_t value = (i / 8) * 500 + ((seed + i) % 5);
+			buffer[2 * i] = value & 0xFF;
+			buffer[2 * i + 1] = value >> 8;
+		}
+	}
+	else if (kind == REPEATED) {
+		memset(buffer, seed & 0xFF, SP_MAX_DATA_LEN);
+	}
+	else {
+		for (sp_len_t i = 0; i < SP_MAX_DATA_LEN; ++i) {
+			seed = seed * 1103515245 + 12345;
+			buffer[i] = seed >> 16;
+		}
+	}
+	return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkCodec() {
+	uint8_t plain[SP_MAX_DATA_LEN];
+	uint8_t packed[SP_MAX_DATA_LEN * 2];
+	uint8_t unpacked[SP_MAX_DATA_LEN];
+	for (uint32_t seed = 0; seed < 1000; ++seed) {
+		for (uint8_t kind = 0; kind < PAYLOADS; ++kind) {
+			sp_len_t len = makePayload((Payload) kind, plain, seed);
+			// Any prefix, so the groups of items end everywhere
+			len = seed % 3 ? len : seed % (len + 1);
+			uint16_t packedLen = SimpleLZ::compress(plain, len, packed, sizeof(packed));
+			benchCheck(len == 0 || packedLen > 0, "compress");
+			benchCheck(SimpleLZ::decompress(packed, packedLen, unpacked, sizeof(unpacked)) == len
+					&& memcmp(plain, unpacked, len) == 0, "compression round trip");
+			if (packedLen > 1) {
+				benchCheck(SimpleLZ::compress(plain, len, packed, packedLen - 1) == 0, "compression limit");
+			}
+		}
+	}
+
+	// Matches before the start of the output or beyond its end are invalid
+	static const uint8_t before[] = {0x01, 0x00, 0x00};
+	static const uint8_t beyond[] = {0x02, 'a', 0x00, 0x0F};
+	benchCheck(SimpleLZ::decompress(before, sizeof(before), unpacked, sizeof(unpacked)) == 0, "match before the output");
+	benchCheck(SimpleLZ::decompress(beyond, sizeof(beyond), unpacked, 8) == 0, "match beyond the output");
+#if SP_MAX_DATA_LEN >= 19
+	benchCheck(SimpleLZ::decompress(beyond, sizeof(beyond), unpacked, 19) == 19 && unpacked[18] == 'a', "overlapping match");
+#endif
+}
+
+#ifdef SP_COMPRESSION
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkLink() {
+	MockStream stream;
+	SimpleCommLink link(stream, 3);
+	SimpleCommLink receiver(stream, 4);
+	link.setCompression(32);
+	SimplePacket rx;
+
+#if SP_MAX_DATA_LEN >= 96
+	// The sample payloads only compress with a few records of them
+	SimpleCommLink plainLink(stream, 5);
+	SimplePacket tx;
+	uint8_t plain[SP_MAX_DATA_LEN];
+	for (uint8_t bulk = 0; bulk < 2; ++bulk) {
+		receiver.setBulkRead(bulk);
+		for (uint8_t kind = 0; kind < PAYLOADS; ++kind) {
+			sp_len_t len = makePayload((Payload) kind, plain, kind);
+			tx.setData(plain, len);
+			stream.resetCounters();
+			benchCheck(link.send(tx, 4, kind), "send compressed");
+			benchCheck((stream.available() < FRAME_OVERHEAD + len) == (kind != RANDOM), "compressed frame length");
+			benchCheck(tx.getDataLength() == len && memcmp(tx.getData(), plain, len) == 0, "packet kept after compression");
+			benchCheck(receiver.receive(rx) && rx.getType() == kind && rx.getDataLength() == len
+					&& memcmp(rx.getData(), plain, len) == 0, "compressed frame received");
+
+			// Forwarding it uncompressed relies on the check kept for the plain payload
+			plainLink.send(rx, 4);
+			benchCheck(receiver.receive(rx) && rx.getDataLength() == len && memcmp(rx.getData(), plain, len) == 0, "decompressed frame forwarded");
+		}
+	}
+
+	// Short payloads are not worth it
+	memset(plain, 'x', 31);
+	tx.setData(plain, 31);
+	link.send(tx, 4);
+	benchCheck(stream.available() == FRAME_OVERHEAD + 31 && stream.peek() == SP_SYN_VALUE, "short payload left alone");
+	benchCheck(receiver.receive(rx) && rx.getDataLength() == 31, "short payload received");
+#endif
+
+	// A frame with a good CRC but a broken compressed payload
+	uint8_t frame[] = {SP_SYN_VALUE | SP_SYN_COMPRESSED, 0, 4, 3, 0, 0x01, 0x10, 0x00, 0, 0};
+	frame[SP_SYN_LEN] = SP_HDR_LEN + 3 + SP_CRC_LEN;
+	sp_crc_t crc = SimpleComm.calcCRC(frame + SP_SYN_LEN + SP_LEN_LEN, SP_HDR_LEN + 3);
+	frame[SP_SYN_LEN + SP_LEN_LEN + SP_HDR_LEN + 3] = crc & 0xFF;
+#if SP_CRC_LEN == 2
+	frame[SP_SYN_LEN + SP_LEN_LEN + SP_HDR_LEN + 4] = crc >> 8;
+#endif
+	receiver.resetStats();
+	stream.write(frame, SP_SYN_LEN + SP_LEN_LEN + frame[SP_SYN_LEN]);
+	benchCheck(!receiver.receive(rx) && receiver.getStats().formatErrors == 1 && receiver.getStats().crcErrors == 0, "broken compressed payload");
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchPayload(Payload kind) {
+	static const char *names[] = {"text status", "register block", "repeated byte", "random"};
+	uint8_t plain[SP_MAX_DATA_LEN];
+	uint8_t packed[SP_MAX_DATA_LEN];
+	uint8_t unpacked[SP_MAX_DATA_LEN];
+
+	// Average size over a series of payloads
+	unsigned long plainBytes = 0;
+	unsigned long packedBytes = 0;
+	for (uint32_t seed = 0; seed < 100; ++seed) {
+		sp_len_t len = makePayload(kind, plain, seed);
+		uint16_t packedLen = SimpleLZ::compress(plain, len, packed, len - 1);
+		plainBytes += len;
+		packedBytes += packedLen ? packedLen : len;
+	}
+
+	sp_len_t len = makePayload(kind, plain, 1);
+	uint16_t packedLen = SimpleLZ::compress(plain, len, packed, len);
+	unsigned long iterations = benchIterations(len) / 8;
+	double compressNs = 0;
+	double decompressNs = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		BenchTimer timer;
+		SimpleLZ::compress(plain, len, packed, len);
+		compressNs += timer.elapsedNs();
+		timer.start();
+		SimpleLZ::decompress(packed, packedLen, unpacked, sizeof(unpacked));
+		decompressNs += timer.elapsedNs();
+	}
+
+	double plainFrame = (double) plainBytes / 100 + FRAME_OVERHEAD;
+	double packedFrame = (double) packedBytes / 100 + FRAME_OVERHEAD;
+	benchNote("%-28s %5.1f -> %5.1f bytes (%3.0f%%), %5.1f ms -> %5.1f ms at 19200 bps, compress %5.0f ns, decompress %4.0f ns",
+			names[kind], (double) plainBytes / 100, (double) packedBytes / 100, 100.0 * packedBytes / plainBytes,
+			plainFrame * BYTE_TIME_US / 1000, packedFrame * BYTE_TIME_US / 1000, compressNs / iterations, decompressNs / iterations);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchCompress() {
+	checkCodec();
+#ifdef SP_COMPRESSION
+	checkLink();
+#endif
+
+	benchSection("Payload compression (SimpleLZ)");
+	for (uint8_t kind = 0; kind < PAYLOADS; ++kind) {
+		benchPayload((Payload) kind);
+	}
+}
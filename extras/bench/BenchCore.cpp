@@ -0,0 +1,285 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+// Payloads too long for a 1-byte LEN go in long frames
+#define FRAME_LEN(dlen) (SP_SYN_LEN + ((dlen) > SP_SHORT_MAX_DATA_LEN ? SP_LEN_EXT_LEN : 0) + SP_LEN_LEN + SP_HDR_LEN + (dlen) + SP_CRC_LEN)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchEncode(sp_len_t len) {
+	MockStream stream;
+	SimplePacket packet;
+	benchFillPacket(packet, len);
+
+	unsigned long iterations = benchIterations(FRAME_LEN(len));
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		SimpleComm.send(stream, packet, 1, 0x10);
+		stream.clear();
+	}
+	double ns = timer.elapsedNs();
+
+	benchCheck(stream.writeCalls == iterations, "one write per encoded packet");
+	benchReport("encode (send)", len, iterations, iterations * FRAME_LEN(len), ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchDecode(sp_len_t len, bool bulkRead) {
+	MockStream stream(1 << 16);
+	SimplePacket packet;
+	benchFillPacket(packet, len);
+	SimpleComm.send(stream, packet, 1, 0x10);
+	uint8_t frame[FRAME_LEN(SP_MAX_DATA_LEN)];
+	stream.readBytes(frame, FRAME_LEN(len));
+
+	unsigned long batch = (1 << 16) / FRAME_LEN(len);
+	unsigned long iterations = benchIterations(FRAME_LEN(len));
+	unsigned long received = 0;
+	sp_len_t lastLen = 0;
+	double ns = 0;
+	SimpleComm.setBulkRead(bulkRead);
+	stream.resetCounters();
+	while (received < iterations) {
+		stream.clear();
+		for (unsigned long i = 0; i < batch; ++i) {
+			stream.write(frame, FRAME_LEN(len));
+		}
+
+		BenchTimer timer;
+		while (SimpleComm.receive(stream, packet)) {
+			lastLen = packet.getDataLength();
+			++received;
+		}
+		ns += timer.elapsedNs();
+	}
+
+	SimpleComm.setBulkRead(false);
+
+	benchCheck(lastLen == len, "decoded payload length");
+	benchReport(bulkRead ? "decode (bulk read)" : "decode (receive)", len, received, received * FRAME_LEN(len), ns);
+	benchNote("%-28s %8s virtual calls/packet: available %.2f, read %.2f, readBytes %.2f", "", "",
+			(double) stream.availableCalls / received,
+			(double) stream.readCalls / received,
+			(double) stream.readBytesCalls / received);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchCRC(sp_len_t len) {
+	uint8_t buffer[SP_HDR_LEN + SP_MAX_DATA_LEN];
+	for (size_t i = 0; i < sizeof(buffer); ++i) {
+		buffer[i] = i;
+	}
+
+	unsigned long iterations = benchIterations(SP_HDR_LEN + len);
+	volatile sp_crc_t sink = 0;
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		buffer[0] = (uint8_t) i;
+		sink = sink + SimpleCommClass::calcCRC(buffer, SP_HDR_LEN + len);
+	}
+	double ns = timer.elapsedNs();
+
+	benchReport("crc", len, iterations, iterations * (SP_HDR_LEN + len), ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchRoundTrip(sp_len_t len) {
+	MockStream stream;
+	SimplePacket tx;
+	SimplePacket rx;
+
+	unsigned long iterations = benchIterations(FRAME_LEN(len));
+	unsigned long received = 0;
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		benchFillPacket(tx, len, (uint8_t) i);
+		SimpleComm.send(stream, tx, 1, 0x10);
+		if (SimpleComm.receive(stream, rx)) {
+			++received;
+		}
+	}
+	double ns = timer.elapsedNs();
+
+	benchCheck(received == iterations, "every sent packet is received");
+	benchCheck(rx.getDataLength() == len
+			&& memcmp(rx.getData(), tx.getData(), len) == 0, "round-trip payload");
+	benchReport("round-trip", len, iterations, iterations * FRAME_LEN(len), ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkJunkPrefix(bool bulkRead) {
+	static const uint8_t junk[] = {0x00, 0xFF, SP_SYN_VALUE, 0x01, 0x55};
+	MockStream stream;
+	SimplePacket tx;
+	SimplePacket rx;
+	benchFillPacket(tx, 16);
+
+	SimpleComm.setBulkRead(bulkRead);
+	stream.write(junk, sizeof(junk));
+	SimpleComm.send(stream, tx, 1, 0x10);
+	bool received = SimpleComm.receive(stream, rx);
+	SimpleComm.setBulkRead(false);
+
+	benchCheck(received && rx.getDataLength() == 16
+			&& memcmp(rx.getData(), tx.getData(), 16) == 0, "frame after junk bytes is received");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkEcho() {
+	// A received packet sent back as is, as the TCP echo server does
+	MockStream stream;
+	SimplePacket tx;
+	SimplePacket rx;
+	benchFillPacket(tx, BENCH_LEN(24));
+	tx.addData((SP_INT) 1234);
+
+	bool received = SimpleComm.send(stream, tx, 1, 0x10) && SimpleComm.receive(stream, rx);
+	received = received && SimpleComm.send(stream, rx, 2) && SimpleComm.receive(stream, rx);
+	benchCheck(received && rx.getDataLength() == tx.getDataLength()
+			&& memcmp(rx.getData(), tx.getData(), tx.getDataLength()) == 0, "echoed packet is received");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkExhausted() {
+	// A received packet is cleared by the next receive(), as it always was
+	MockStream stream;
+	SimplePacket tx;
+	SimplePacket rx;
+	benchFillPacket(tx, 12);
+
+	SimpleComm.send(stream, tx, 1, 0x10);
+	bool received = SimpleComm.receive(stream, rx);
+	benchCheck(received && !SimpleComm.receive(stream, rx) && rx.getDataLength() == 0, "received packet cleared by the next call");
+
+	rx.setData("kept");
+	benchCheck(!SimpleComm.receive(stream, rx) && strcmp(rx.getString(), "kept") == 0, "other packets are not cleared");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkLinks() {
+	// Two links with different addresses, fed alternately byte by byte
+	MockStream streamA;
+	MockStream streamB;
+	SimpleCommLink linkA(streamA, 1);
+	SimpleCommLink linkB(streamB, 2);
+	SimplePacket tx;
+	SimplePacket rxA;
+	SimplePacket rxB;
+
+	MockStream wire;
+	SimpleCommLink sender(wire, 9);
+	uint8_t frameA[SP_BUFFER_SIZE];
+	uint8_t frameB[SP_BUFFER_SIZE];
+	benchFillPacket(tx, BENCH_LEN(20), 1);
+	sender.send(tx, 1, 0xA);
+	size_t lenA = wire.readBytes(frameA, sizeof(frameA));
+	benchFillPacket(tx, BENCH_LEN(30), 2);
+	sender.send(tx, 2, 0xB);
+	size_t lenB = wire.readBytes(frameB, sizeof(frameB));
+
+	bool gotA = false;
+	bool gotB = false;
+	for (size_t i = 0; i < lenA || i < lenB; ++i) {
+		if (i < lenA) {
+			streamA.write(frameA[i]);
+			gotA = linkA.receive(rxA);
+		}
+		if (i < lenB) {
+			streamB.write(frameB[i]);
+			gotB = linkB.receive(rxB);
+		}
+	}
+	benchCheck(gotA && rxA.getType() == 0xA && rxA.getSource() == 9 && rxA.getDataLength() == BENCH_LEN(20), "link A");
+	benchCheck(gotB && rxB.getType() == 0xB && rxB.getDataLength() == BENCH_LEN(30), "link B");
+
+	// Link A rejects a frame for address 2
+	streamA.write(frameB, lenB);
+	benchCheck(!linkA.receive(rxA) && linkA.getStats().addressRejects == 1, "link address filter");
+	benchCheck(linkA.getStats().packetsReceived == 1 && linkB.getStats().packetsReceived == 1, "link statistics");
+
+	// A partial frame follows the link when receive() gets another packet
+	streamA.write(frameA, 10);
+	benchCheck(!linkA.receive(rxA), "partial frame");
+	streamA.write(frameA + 10, lenA - 10);
+	benchFillPacket(tx, BENCH_LEN(20), 1);
+	benchCheck(linkA.receive(rxB) && rxB.getType() == 0xA && rxB.getDataLength() == BENCH_LEN(20)
+			&& memcmp(rxB.getData(), tx.getData(), BENCH_LEN(20)) == 0, "partial frame carried over");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchLatency(sp_len_t len, bool bulkRead) {
+	// Time from the last byte of a frame being available to receive() returning true
+	MockStream stream;
+	SimplePacket packet;
+	benchFillPacket(packet, len);
+	SimpleComm.send(stream, packet, 1, 0x10);
+	uint8_t frame[FRAME_LEN(SP_MAX_DATA_LEN)];
+	stream.readBytes(frame, FRAME_LEN(len));
+
+	unsigned long iterations = benchIterations(FRAME_LEN(len) * 8);
+	unsigned long received = 0;
+	double ns = 0;
+	SimpleComm.setBulkRead(bulkRead);
+	for (unsigned long i = 0; i < iterations; ++i) {
+		stream.write(frame, FRAME_LEN(len) - 1);
+		SimpleComm.receive(stream, packet);
+		stream.write(frame + FRAME_LEN(len) - 1, 1);
+
+		BenchTimer timer;
+		received += SimpleComm.receive(stream, packet);
+		ns += timer.elapsedNs();
+	}
+	SimpleComm.setBulkRead(false);
+
+	benchCheck(received == iterations, "every frame completes on its last byte");
+	benchReport(bulkRead ? "last byte latency (bulk)" : "last byte latency", len, iterations, iterations * FRAME_LEN(len), ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchCore() {
+	SimpleComm.begin(0);
+
+	checkJunkPrefix(false);
+	checkJunkPrefix(true);
+	checkEcho();
+	checkExhausted();
+	checkLinks();
+
+	benchSection("SimpleComm core");
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchEncode(benchPayloadSizes[i]);
+	}
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchDecode(benchPayloadSizes[i], false);
+	}
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchDecode(benchPayloadSizes[i], true);
+	}
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchCRC(benchPayloadSizes[i]);
+	}
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchRoundTrip(benchPayloadSizes[i]);
+	}
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchLatency(benchPayloadSizes[i], false);
+	}
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchLatency(benchPayloadSizes[i], true);
+	}
+}
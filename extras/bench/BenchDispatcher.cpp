@@ -0,0 +1,168 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommDispatcher.h>
+#include <SimpleCommReceiver.h>
+
+// Packet types of the benchmark traffic
+#define TYPES 32
+
+static uint32_t handled[TYPES];
+static uint32_t defaulted;
+static volatile uint32_t sink;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <uint8_t T>
+static void handler(SimplePacketBase &packet) {
+	++handled[T];
+	sink = sink + packet.getDataLength();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void defaultHandler(SimplePacketBase &packet) {
+	(void) packet;
+	++defaulted;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void send(MockStream &stream, uint8_t source, uint8_t type, sp_len_t len) {
+	SimpleCommLink sender(stream, source);
+	SimplePacket tx;
+	benchFillPacket(tx, len, type);
+	sender.send(tx, 1, type);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkDispatcher() {
+	MockStream stream;
+	SimpleCommLink link(stream, 1);
+	SimpleCommDispatcherBuffer<4, 0x20> dispatcher(link);
+	memset(handled, 0, sizeof(handled));
+	defaulted = 0;
+
+	benchCheck(dispatcher.on(0x20, handler<0>) && dispatcher.on(0x23, handler<3>, 7), "handlers in the table");
+	benchCheck(!dispatcher.on(0x1F, handler<1>) && !dispatcher.on(0x24, handler<1>), "types outside of the table");
+
+	send(stream, 5, 0x20, 10);
+	send(stream, 7, 0x23, 0);
+	send(stream, 5, 0x23, 0);
+	send(stream, 5, 0x21, 0);
+	send(stream, 5, 0x10, 0);
+	benchCheck(dispatcher.poll() == 5 && handled[0] == 1 && handled[3] == 1 && dispatcher.getUnhandled() == 3, "dispatch by type and source");
+
+	dispatcher.setDefault(defaultHandler);
+	dispatcher.off(0x20);
+	send(stream, 5, 0x20, 0);
+	benchCheck(dispatcher.poll() == 1 && handled[0] == 1 && defaulted == 1, "default handler");
+
+	// A frame split across polls completes in the dispatcher's packet
+	send(stream, 7, 0x23, BENCH_LEN(20));
+	uint8_t bytes[SP_BUFFER_SIZE];
+	size_t count = stream.readBytes(bytes, sizeof(bytes));
+	stream.write(bytes, 5);
+	benchCheck(dispatcher.poll() == 0, "partial frame");
+	stream.write(bytes + 5, count - 5);
+	benchCheck(dispatcher.poll() == 1 && handled[3] == 2, "split frame dispatched");
+
+	// Packets queued by a receiver
+	SimpleCommReceiverBuffer<4> receiver(link);
+	send(stream, 7, 0x23, 0);
+	receiver.poll();
+	benchCheck(dispatcher.dispatch(*receiver.peek()) && handled[3] == 3, "dispatch from a receiver");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void switchOnType(SimplePacketBase &packet) {
+	// What receivers do today
+	switch (packet.getType()) {
+#define CASE(T) case T: handler<T>(packet); break;
+		CASE(0) CASE(1) CASE(2) CASE(3) CASE(4) CASE(5) CASE(6) CASE(7)
+		CASE(8) CASE(9) CASE(10) CASE(11) CASE(12) CASE(13) CASE(14) CASE(15)
+		CASE(16) CASE(17) CASE(18) CASE(19) CASE(20) CASE(21) CASE(22) CASE(23)
+		CASE(24) CASE(25) CASE(26) CASE(27) CASE(28) CASE(29) CASE(30) CASE(31)
+#undef CASE
+		default: defaultHandler(packet); break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchDispatch(sp_len_t len, bool useDispatcher) {
+	MockStream bus(TYPES * SP_BUFFER_SIZE);
+	for (uint8_t i = 0; i < TYPES; ++i) {
+		// A fixed shuffle, so the types don't come in order
+		send(bus, 5, (i * 13) % TYPES, len);
+	}
+	size_t total = bus.available();
+	static uint8_t bytes[TYPES * SP_BUFFER_SIZE];
+	bus.readBytes(bytes, total);
+
+	MockStream stream(TYPES * SP_BUFFER_SIZE);
+	SimpleCommLink link(stream, 1);
+	link.setBulkRead(true);
+	SimpleCommDispatcherBuffer<TYPES> dispatcher(link);
+	SimpleCommPacketHandler handlers[TYPES] = {
+		handler<0>, handler<1>, handler<2>, handler<3>, handler<4>, handler<5>, handler<6>, handler<7>,
+		handler<8>, handler<9>, handler<10>, handler<11>, handler<12>, handler<13>, handler<14>, handler<15>,
+		handler<16>, handler<17>, handler<18>, handler<19>, handler<20>, handler<21>, handler<22>, handler<23>,
+		handler<24>, handler<25>, handler<26>, handler<27>, handler<28>, handler<29>, handler<30>, handler<31>,
+	};
+	for (uint8_t i = 0; i < TYPES; ++i) {
+		dispatcher.on(i, handlers[i]);
+	}
+	SimplePacket rx;
+	memset(handled, 0, sizeof(handled));
+
+	unsigned long iterations = benchIterations(total);
+	double ns = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		stream.clear();
+		stream.write(bytes, total);
+
+		BenchTimer timer;
+		if (useDispatcher) {
+			dispatcher.poll();
+		}
+		else {
+			while (link.receive(rx)) {
+				switchOnType(rx);
+			}
+		}
+		ns += timer.elapsedNs();
+	}
+
+	uint32_t packets = 0;
+	bool even = true;
+	for (uint8_t i = 0; i < TYPES; ++i) {
+		packets += handled[i];
+		even = even && handled[i] == iterations;
+	}
+	benchCheck(even, "every type is handled once per burst");
+	benchReport(useDispatcher ? "32 types (dispatcher)" : "32 types (receive+switch)", len, packets, iterations * total, ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchDispatcher() {
+	checkDispatcher();
+
+	benchSection("Type dispatch (bulk read)");
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchDispatch(benchPayloadSizes[i], false);
+		benchDispatch(benchPayloadSizes[i], true);
+	}
+}
@@ -0,0 +1,242 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommFragment.h>
+
+#include "SimLine.h"
+
+// 19200 bps, 8N1
+#define BYTE_TIME 521
+// One-way delay of the line (radio modem, gateway...)
+#define LATENCY 20000UL
+#define STEP 250
+
+// Two endpoints joined by a lossy line: the fragmenter on link 1, the
+// reassembler on link 2
+struct FragmentRig {
+	MockStream inA;
+	MockStream inB;
+	SimLine lineAB;
+	SimLine lineBA;
+	SimpleCommLink txA;
+	SimpleCommLink rxA;
+	SimpleCommLink txB;
+	SimpleCommLink rxB;
+	SimpleCommFragmenter fragmenter;
+	SimpleCommReassembler reassembler;
+	SimplePacket packetA;
+	SimplePacket packetB;
+	unsigned long others;
+
+	FragmentRig(uint8_t *buffer, uint32_t size, uint8_t loss) : inA(1 << 16), inB(1 << 16),
+			lineAB(inB, loss, BYTE_TIME, LATENCY), lineBA(inA, loss, BYTE_TIME, LATENCY),
+			txA(lineAB, 1), rxA(inA, 1), txB(lineBA, 2), rxB(inB, 2),
+			fragmenter(txA), reassembler(txB, buffer, size), others(0) {
+		txA.setClock(simClock);
+		txB.setClock(simClock);
+		// A corrupted LEN would swallow the frames behind it
+		rxA.setClock(simClock);
+		rxB.setClock(simClock);
+		rxA.setTimeouts(3 * BYTE_TIME);
+		rxB.setTimeouts(3 * BYTE_TIME);
+	}
+
+	// One STEP of the simulation
+	void step() {
+		fragmenter.poll();
+		lineAB.deliver();
+		while (rxB.receive(packetB)) {
+			others += !reassembler.handle(packetB);
+		}
+		lineBA.deliver();
+		while (rxA.receive(packetA)) {
+			others += !fragmenter.handle(packetA);
+		}
+		simNow += STEP;
+	}
+
+	bool run(unsigned long limit) {
+		unsigned long end = simNow + limit;
+		while (fragmenter.isBusy() && simNow < end) {
+			step();
+		}
+		// Let the last ACKs and resent fragments arrive
+		for (unsigned long i = 0; i < 2 * LATENCY / STEP + 1000; ++i) {
+			step();
+		}
+		return !fragmenter.isBusy();
+	}
+};
+
+// Time to send a window of fragments and get the ACK, plus a margin
+static unsigned long windowTime(uint8_t window) {
+	return window * (SP_MAX_DATA_LEN + 10UL) * BYTE_TIME + 2 * LATENCY + 50000UL;
+}
+
+// Room for the lossy line messages of 20 fragments and a bit
+#define MESSAGE_LEN (21UL * SP_MAX_DATA_LEN > 65536UL ? 21UL * SP_MAX_DATA_LEN : 65536UL)
+
+static uint8_t message[MESSAGE_LEN];
+static uint8_t received[MESSAGE_LEN];
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void fillMessage(uint32_t len, uint8_t seed) {
+	for (uint32_t i = 0; i < len; ++i) {
+		message[i] = (uint8_t) (i * 7 + (i >> 8) + seed);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkFragment() {
+	simNow = 0;
+	simSeed(1);
+
+	// Clean line, then a second message once the first one is released
+	{
+		FragmentRig rig(received, sizeof(received), 0);
+		rig.fragmenter.setWindow(4);
+		rig.fragmenter.setTimeout(windowTime(4));
+		fillMessage(3000, 1);
+		benchCheck(rig.fragmenter.send(message, 3000, 2) && !rig.fragmenter.send(message, 10, 2), "fragmenter accepts one message at a time");
+		benchCheck(rig.run(10000000UL) && !rig.fragmenter.hasFailed(), "message delivered");
+		benchCheck(rig.reassembler.isComplete() && rig.reassembler.getLength() == 3000 && rig.reassembler.getSource() == 1
+				&& memcmp(received, message, 3000) == 0, "message reassembled");
+		benchCheck(rig.fragmenter.getRetransmissions() == 0, "no retransmission on a clean line");
+
+		fillMessage(3000, 2);
+		rig.fragmenter.send(message, 500, 2);
+		rig.run(windowTime(4));
+		benchCheck(rig.reassembler.isComplete() && rig.reassembler.getLength() == 3000, "next message waits for release");
+		rig.reassembler.release();
+		benchCheck(rig.run(20000000UL) && !rig.fragmenter.hasFailed()
+				&& rig.reassembler.isComplete() && rig.reassembler.getLength() == 500
+				&& memcmp(received, message, 500) == 0, "next message after release");
+		rig.reassembler.release();
+
+		benchCheck(rig.fragmenter.send(message, 0, 2) && rig.run(10000000UL)
+				&& rig.reassembler.isComplete() && rig.reassembler.getLength() == 0, "empty message");
+		rig.reassembler.release();
+
+		// Other packets go through
+		SimplePacket packet;
+		packet.setData("other");
+		rig.txA.send(packet, 2, 0x10);
+		rig.run(0);
+		benchCheck(rig.others == 1, "other packets are not consumed");
+	}
+
+	// Lossy line, both ways
+	uint32_t len = 20UL * (SP_MAX_DATA_LEN - SimpleCommFragment::HEADER_LEN) + 7;
+	for (uint8_t window = 1; window <= SimpleCommFragment::MAX_WINDOW; window *= 2) {
+		FragmentRig rig(received, sizeof(received), 20);
+		rig.fragmenter.setWindow(window);
+		rig.fragmenter.setTimeout(windowTime(window));
+		rig.fragmenter.setRetries(20);
+		fillMessage(len, window);
+		rig.fragmenter.send(message, len, 2);
+		benchCheck(rig.run(600000000UL) && !rig.fragmenter.hasFailed()
+				&& rig.reassembler.isComplete() && rig.reassembler.getLength() == len
+				&& memcmp(received, message, len) == 0, "message delivered over a lossy line");
+		benchCheck(rig.fragmenter.getRetransmissions() > 0, "lost fragments are resent");
+	}
+
+	// A sender stopping partway doesn't block the others for ever. Times
+	// are in windows of 2 fragments, whose frames may take seconds.
+	{
+		unsigned long window = windowTime(2);
+		FragmentRig rig(received, sizeof(received), 0);
+		rig.reassembler.setTimeout(4 * window);
+		rig.fragmenter.setWindow(2);
+		rig.fragmenter.setTimeout(window);
+		uint32_t chunk = SP_MAX_DATA_LEN - SimpleCommFragment::HEADER_LEN;
+		fillMessage(20 * chunk, 3);
+		rig.fragmenter.send(message, 20 * chunk, 2);
+		rig.run(window);
+		rig.fragmenter.cancel();
+		// The fragments in flight arrive within a window
+		for (unsigned long end = simNow + 2 * window; simNow < end; ) {
+			rig.step();
+		}
+		benchCheck(!rig.reassembler.isComplete(), "first sender stopped partway");
+
+		SimpleCommLink txC(rig.lineAB, 3);
+		txC.setClock(simClock);
+		SimpleCommFragmenter other(txC);
+		other.setTimeout(window / 4);
+		other.setRetries(40);
+		// Its ACKs are not delivered: it resends its single fragment
+		other.send(message, 7, 2);
+		for (unsigned long end = simNow + window; simNow < end; ) {
+			other.poll();
+			rig.step();
+		}
+		benchCheck(!rig.reassembler.isComplete(), "other sender waits for the timeout");
+		for (unsigned long end = simNow + 6 * window; simNow < end && !rig.reassembler.isComplete(); ) {
+			other.poll();
+			rig.step();
+		}
+		benchCheck(rig.reassembler.isComplete() && rig.reassembler.getSource() == 3 && rig.reassembler.getLength() == 7
+				&& memcmp(received, message, 7) == 0, "stalled message dropped for another sender");
+	}
+
+	// A message larger than the buffer is given up
+	{
+		FragmentRig rig(received, 1000, 0);
+		rig.fragmenter.setTimeout(windowTime(8));
+		rig.fragmenter.setRetries(2);
+		rig.fragmenter.send(message, 3000, 2);
+		benchCheck(rig.run(60000000UL) && rig.fragmenter.hasFailed() && !rig.reassembler.isComplete(), "oversized message fails");
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchTransfer(uint32_t len, uint8_t window, uint8_t loss) {
+	simNow = 0;
+	simSeed(7);
+	FragmentRig rig(received, sizeof(received), loss);
+	rig.fragmenter.setWindow(window);
+	rig.fragmenter.setTimeout(windowTime(window));
+	rig.fragmenter.setRetries(50);
+	fillMessage(len, window);
+
+	rig.fragmenter.send(message, len, 2);
+	while (rig.fragmenter.isBusy() && simNow < 3600000000UL) {
+		rig.step();
+	}
+	double seconds = simNow / 1e6;
+
+	benchCheck(rig.reassembler.isComplete() && memcmp(received, message, len) == 0, "transfer completes");
+	benchNote("%-18s window %2u, loss %2u%%: %7.0f bytes/s, %6.2f s, %4u resent", "fragmented message",
+			window, loss, len / seconds, seconds, (unsigned) rig.fragmenter.getRetransmissions());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchFragment() {
+	checkFragment();
+
+	uint32_t len = benchQuick ? 4096 : 16384;
+	benchSection("Fragmentation (19200 bps, 20 ms latency, simulated)");
+	benchNote("%u bytes message, %u bytes per fragment", (unsigned) len, (unsigned) (SP_MAX_DATA_LEN - SimpleCommFragment::HEADER_LEN));
+	static const uint8_t losses[] = {0, 2, 10};
+	for (uint8_t i = 0; i < sizeof(losses); ++i) {
+		for (uint8_t window = 1; window <= 16; window *= 2) {
+			benchTransfer(len, window, losses[i]);
+		}
+	}
+}
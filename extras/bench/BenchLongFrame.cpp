@@ -0,0 +1,213 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#define TRANSFER_LEN 16384UL
+
+// Per chunk: an ACK frame back and two bus turnarounds
+#define ACK_LEN (SP_SYN_LEN + SP_LEN_LEN + SP_HDR_LEN + SP_CRC_LEN)
+#define TURNAROUND_US 1000
+
+// Payloads too long for a 1-byte LEN go in long frames
+#define FRAME_LEN(dlen) (SP_SYN_LEN + ((dlen) > SP_SHORT_MAX_DATA_LEN ? SP_LEN_EXT_LEN : 0) + SP_LEN_LEN + SP_HDR_LEN + (dlen) + SP_CRC_LEN)
+#define LONG_FRAME_LEN(dlen) (SP_SYN_LEN + 2 * SP_LEN_LEN + SP_HDR_LEN + (dlen) + SP_CRC_LEN)
+
+// Lengths of the checks, within SP_MAX_DATA_LEN: a short payload, and a
+// long one this build receives when it has long frames
+#define CLASSIC_LEN (SP_MAX_DATA_LEN < 100 ? SP_MAX_DATA_LEN : 100)
+#ifdef SP_LONG_FRAMES
+#define LONG_LEN ((SP_SHORT_MAX_DATA_LEN + 1 + SP_MAX_DATA_LEN) / 2)
+#else
+#define LONG_LEN 300
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Builds by hand a long frame of len bytes of 0x55 to dst, as a device built
+// with a large SP_MAX_DATA_LEN sends it
+static size_t makeLongFrame(uint8_t *frame, uint16_t len, uint8_t dst) {
+	uint16_t tlen = SP_HDR_LEN + len + SP_CRC_LEN;
+	size_t pos = 0;
+	frame[pos++] = SP_SYN_VALUE | SP_SYN_LONG;
+	frame[pos++] = tlen >> 8;
+	frame[pos++] = tlen & 0xFF;
+	frame[pos++] = dst;
+	frame[pos++] = 9;
+	frame[pos++] = 0x30;
+	memset(frame + pos, 0x55, len);
+	pos += len;
+	sp_crc_t crc = SimpleComm.calcCRC(frame + 3, SP_HDR_LEN + len);
+	frame[pos++] = crc & 0xFF;
+#if SP_CRC_LEN == 2
+	frame[pos++] = crc >> 8;
+#endif
+	return pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkLongFrames() {
+	MockStream stream(16 * SP_BUFFER_SIZE);
+	SimpleCommLink link(stream, 4);
+	SimplePacket tx;
+	SimplePacket rx;
+
+	// Payloads that fit keep the classic frame, whatever SP_MAX_DATA_LEN is
+	benchFillPacket(tx, CLASSIC_LEN);
+	link.send(tx, 4, 0x20);
+	uint8_t head[2];
+	stream.readBytes(head, 2);
+	benchCheck(head[0] == SP_SYN_VALUE && head[1] == SP_HDR_LEN + CLASSIC_LEN + SP_CRC_LEN, "classic frame for short payloads");
+	stream.clear();
+
+	// Devices without long frames skip them and keep receiving the rest
+	uint8_t frame[LONG_FRAME_LEN(LONG_LEN)];
+	size_t frameLen = makeLongFrame(frame, LONG_LEN, 4);
+	for (uint8_t bulk = 0; bulk < 2; ++bulk) {
+		link.setBulkRead(bulk);
+		link.resetStats();
+		stream.write(frame, frameLen);
+		link.send(tx, 4, 0x21);
+		uint8_t lastType = 0;
+		bool gotLong = false;
+		while (link.receive(rx)) {
+			lastType = rx.getType();
+			gotLong = gotLong || lastType == 0x30;
+		}
+#ifdef SP_LONG_FRAMES
+		benchCheck(gotLong && lastType == 0x21 && link.getStats().packetsReceived == 2, "long and classic frames");
+#else
+		benchCheck(!gotLong && lastType == 0x21 && link.getStats().packetsReceived == 1
+				&& link.getStats().bytesDropped >= LONG_LEN, "long frame skipped");
+#endif
+	}
+
+#ifdef SP_LONG_FRAMES
+	// Mixed lengths, both ways of reading, with noise and a corrupted long
+	// frame in between
+	static const sp_len_t lengths[] = {SP_MAX_DATA_LEN, 0, SP_SHORT_MAX_DATA_LEN, SP_SHORT_MAX_DATA_LEN + 1, 1, LONG_LEN};
+	for (uint8_t bulk = 0; bulk < 2; ++bulk) {
+		link.setBulkRead(bulk);
+		link.resetStats();
+		for (uint8_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+			benchFillPacket(tx, lengths[i], i);
+			benchCheck(link.send(tx, 4, i), "send long frame");
+			stream.write((uint8_t) 0xEE);
+		}
+		benchFillPacket(tx, LONG_LEN, 9);
+		link.send(tx, 4, 0xBB);
+		MockStream corrupt(SP_BUFFER_SIZE);
+		SimpleCommLink corrupter(corrupt, 4);
+		corrupter.send(tx, 4, 0xBB);
+		uint8_t bad[SP_BUFFER_SIZE];
+		size_t badLen = corrupt.readBytes(bad, sizeof(bad));
+		bad[badLen / 2] ^= 0x40;
+		stream.write(bad, badLen);
+		benchFillPacket(tx, SP_MAX_DATA_LEN - 1, 7);
+		link.send(tx, 4, 0x77);
+
+		uint8_t i = 0;
+		while (link.receive(rx)) {
+			if (i < sizeof(lengths) / sizeof(lengths[0])) {
+				SimplePacket expected;
+				benchFillPacket(expected, lengths[i], i);
+				benchCheck(rx.getType() == i && rx.getDataLength() == lengths[i]
+						&& memcmp(rx.getData(), expected.getData(), lengths[i]) == 0, "long frame round trip");
+			}
+			++i;
+		}
+		benchCheck(i == sizeof(lengths) / sizeof(lengths[0]) + 2 && rx.getType() == 0x77 && rx.getDataLength() == SP_MAX_DATA_LEN - 1
+				&& link.getStats().crcErrors >= 1, "resynchronised after a corrupted long frame");
+	}
+
+	// A long frame cut between two receive() calls made with different packets
+	link.setBulkRead(false);
+	SimplePacket other;
+	benchFillPacket(tx, SP_MAX_DATA_LEN, 3);
+	link.send(tx, 4, 0x90);
+	uint8_t bytes[SP_BUFFER_SIZE];
+	size_t len = stream.readBytes(bytes, sizeof(bytes));
+	stream.write(bytes, len / 2);
+	benchCheck(!link.receive(rx), "first half of a long frame");
+	stream.write(bytes + len / 2, len - len / 2);
+	benchCheck(link.receive(other) && other.getType() == 0x90 && other.getDataLength() == SP_MAX_DATA_LEN
+			&& memcmp(other.getData(), tx.getData(), SP_MAX_DATA_LEN) == 0, "long frame carried over");
+
+	// LEN beyond SP_MAX_DATA_LEN
+	link.resetStats();
+	frameLen = makeLongFrame(frame, LONG_LEN, 4);
+	frame[1] = 0xFF;
+	stream.write(frame, frameLen);
+	benchCheck(!link.receive(rx) && link.getStats().lengthErrors == 1, "long LEN too large");
+	stream.clear();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchTransfer(sp_len_t chunk) {
+	MockStream stream(1 << 16);
+	SimpleCommLink sender(stream, 1);
+	SimpleCommLink receiver(stream, 2);
+	receiver.setBulkRead(true);
+	SimplePacket tx;
+	SimplePacket rx;
+	static uint8_t image[TRANSFER_LEN];
+	for (unsigned long i = 0; i < TRANSFER_LEN; ++i) {
+		image[i] = i * 7 + (i >> 8);
+	}
+
+	// The whole image, chunk by chunk, through the parser
+	unsigned long frames = (TRANSFER_LEN + chunk - 1) / chunk;
+	unsigned long repeats = benchQuick ? 4 : 64;
+	unsigned long bytes = 0;
+	BenchTimer timer;
+	for (unsigned long r = 0; r < repeats; ++r) {
+		bytes = 0;
+		for (unsigned long offset = 0; offset < TRANSFER_LEN; offset += chunk) {
+			sp_len_t len = TRANSFER_LEN - offset < chunk ? TRANSFER_LEN - offset : chunk;
+			tx.setData(image + offset, len);
+			sender.send(tx, 2, 0x40);
+			bytes += stream.available();
+			if (!receiver.receive(rx) || rx.getDataLength() != len || memcmp(rx.getData(), image + offset, len) != 0) {
+				benchCheck(false, "chunk received");
+			}
+		}
+	}
+	double ns = timer.elapsedNs() / repeats;
+
+	// Line time at 19200 bps, 8N1
+	double lineMs = (bytes + frames * ACK_LEN) * 10 / 19.2 + frames * 2 * TURNAROUND_US / 1000.0;
+	char name[32];
+	snprintf(name, sizeof(name), "chunks of %u%s", (unsigned) chunk, chunk > SP_SHORT_MAX_DATA_LEN ? " (long)" : "");
+	benchNote("%-28s %5lu frames, %6lu bytes, %6.0f ms at 19200 bps with ACKs, host %5.0f ns/KiB",
+			name, frames, bytes, lineMs, ns / (TRANSFER_LEN / 1024));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchLongFrame() {
+	checkLongFrames();
+
+	benchSection("Bulk transfer of 16 KiB");
+	static const uint16_t chunks[] = {64, 128, SP_SHORT_MAX_DATA_LEN, 512, 1024, 4096};
+	for (uint8_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); ++i) {
+		if (chunks[i] <= SP_MAX_DATA_LEN) {
+			benchTransfer(chunks[i]);
+		}
+	}
+#ifndef SP_LONG_FRAMES
+	benchNote("%-28s larger chunks need a larger SP_MAX_DATA_LEN", "");
+#endif
+}
@@ -0,0 +1,186 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleMessage.h>
+#include <SimplePacketReader.h>
+
+// The message of 5 fields needs up to 25 bytes
+#if SP_MAX_DATA_LEN >= 32
+// Same layout as the addData() chain below
+typedef SimpleMessage<SP_INT, SP_UINT, SP_ULONG, SP_DOUBLE, SP_UCHAR> Reading;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void writeChain(SimplePacket &packet, SP_INT a, SP_UINT b, SP_ULONG c, SP_DOUBLE d, SP_UCHAR e) {
+	packet.setData(a);
+	packet.addData(b);
+	packet.addData(c);
+	packet.addData(d);
+	packet.addData(e);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool readChain(const SimplePacket &packet, SP_INT &a, SP_UINT &b, SP_ULONG &c, SP_DOUBLE &d, SP_UCHAR &e) {
+	// The get*() functions only read offset 0: the other fields are cast by hand
+	sp_len_t len;
+	const uint8_t *data = (const uint8_t *) packet.getData(len);
+	if (len != sizeof(a) + sizeof(b) + sizeof(c) + sizeof(d) + sizeof(e)) {
+		return false;
+	}
+	a = packet.getInt();
+	memcpy(&b, data + sizeof(a), sizeof(b));
+	memcpy(&c, data + sizeof(a) + sizeof(b), sizeof(c));
+	memcpy(&d, data + sizeof(a) + sizeof(b) + sizeof(c), sizeof(d));
+	memcpy(&e, data + sizeof(a) + sizeof(b) + sizeof(c) + sizeof(d), sizeof(e));
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool readCursor(const SimplePacket &packet, SP_INT &a, SP_UINT &b, SP_ULONG &c, SP_DOUBLE &d, SP_UCHAR &e) {
+	SimplePacketReader reader(packet);
+	a = reader.read<SP_INT>();
+	b = reader.read<SP_UINT>();
+	c = reader.read<SP_ULONG>();
+	d = reader.read<SP_DOUBLE>();
+	e = reader.read<SP_UCHAR>();
+	return reader.ok();
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkReader() {
+	SimplePacket packet;
+	packet.setData((SP_UCHAR) 0x11);
+	packet.addData((SP_ULONG) 0x12345678);
+	packet.addData("ab");
+	packet.addData((SP_INT) -2);
+
+	// Fields after the first one are unaligned
+	SimplePacketReader reader(packet);
+	benchCheck(reader.read<SP_UCHAR>() == 0x11 && reader.read<SP_ULONG>() == 0x12345678, "reader fields");
+	const char *str = reader.readString();
+	benchCheck(str && strcmp(str, "ab") == 0 && reader.read<SP_INT>() == -2, "reader string");
+	benchCheck(reader.remaining() == 0 && reader.ok(), "reader at the end");
+#if SP_READ_CHECKS
+	benchCheck(reader.read<SP_UCHAR>() == 0 && !reader.ok(), "reader bounds check");
+#endif
+
+	reader.rewind();
+	reader.skip(1);
+	SimplePacketReader view = reader.view(sizeof(SP_ULONG));
+	benchCheck(view.size() == sizeof(SP_ULONG) && view.read<SP_ULONG>() == 0x12345678 && reader.readString() == str, "reader view");
+
+	// The get*() functions don't read beyond the payload
+	packet.setData((SP_CHAR) 'x');
+	benchCheck(packet.getChar() == 'x' && packet.getLong() == 0, "get*() on a short payload");
+}
+
+#if SP_MAX_DATA_LEN >= 32
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkMessage() {
+	SimplePacket chain;
+	SimplePacket message;
+	writeChain(chain, -1234, 5678, 0x12345678, 3.5, 0xAB);
+	Reading::write(message, -1234, 5678, 0x12345678, 3.5, 0xAB);
+	benchCheck(Reading::SIZE == chain.getDataLength() && message.getDataLength() == Reading::SIZE
+			&& memcmp(chain.getData(), message.getData(), Reading::SIZE) == 0, "message layout matches the addData() chain");
+
+	MockStream stream;
+	SimpleCommLink link(stream);
+	SimplePacket rx;
+	link.send(message, 1, 0x10);
+	SP_INT a = 0;
+	SP_UINT b = 0;
+	SP_ULONG c = 0;
+	SP_DOUBLE d = 0;
+	SP_UCHAR e = 0;
+	benchCheck(link.receive(rx) && Reading::read(rx, a, b, c, d, e)
+			&& a == -1234 && b == 5678 && c == 0x12345678 && d == 3.5 && e == 0xAB, "message round trip");
+
+	rx.addData((SP_UCHAR) 0);
+	benchCheck(!Reading::read(rx, a, b, c, d, e), "message length mismatch is rejected");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchWrite(bool useMessage) {
+	SimplePacket packet;
+	unsigned long iterations = benchIterations(Reading::SIZE);
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		if (useMessage) {
+			Reading::write(packet, i, i, i, i, i);
+		}
+		else {
+			writeChain(packet, i, i, i, i, i);
+		}
+		asm volatile("" : : "r"(&packet) : "memory");
+	}
+	double ns = timer.elapsedNs();
+	benchReport(useMessage ? "write (SimpleMessage)" : "write (addData chain)", Reading::SIZE, iterations, iterations * Reading::SIZE, ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchRead(uint8_t mode) {
+	SimplePacket packet;
+	Reading::write(packet, 1, 2, 3, 4, 5);
+	SP_INT a = 0;
+	SP_UINT b = 0;
+	SP_ULONG c = 0;
+	SP_DOUBLE d = 0;
+	SP_UCHAR e = 0;
+	unsigned long sum = 0;
+
+	unsigned long iterations = benchIterations(Reading::SIZE);
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		asm volatile("" : : "r"(&packet) : "memory");
+		if (mode == 0) {
+			readChain(packet, a, b, c, d, e);
+		}
+		else if (mode == 1) {
+			readCursor(packet, a, b, c, d, e);
+		}
+		else {
+			Reading::read(packet, a, b, c, d, e);
+		}
+		sum += a + b + c + (unsigned long) d + e;
+	}
+	double ns = timer.elapsedNs();
+	benchCheck(sum == iterations * 15, "read values");
+	static const char *names[] = {"read (get*/casts)", SP_READ_CHECKS ? "read (reader)" : "read (reader, unchecked)", "read (SimpleMessage)"};
+	benchReport(names[mode], Reading::SIZE, iterations, iterations * Reading::SIZE, ns);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchMessage() {
+	checkReader();
+
+	benchSection("Typed messages, 5 fields");
+#if SP_MAX_DATA_LEN >= 32
+	checkMessage();
+	benchWrite(false);
+	benchWrite(true);
+	benchRead(0);
+	benchRead(1);
+	benchRead(2);
+#else
+	benchNote("%-28s they need a larger SP_MAX_DATA_LEN", "");
+#endif
+}
@@ -0,0 +1,200 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommReceiver.h>
+#include <SimpleCommTxQueue.h>
+#include <SimpleMessage.h>
+
+#define SMALL 8
+#define MEDIUM (SP_MAX_DATA_LEN < 32 ? SP_MAX_DATA_LEN : 32)
+#define BURST 8
+
+typedef BasicSimplePacket<SMALL> SmallPacket;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkCapacity() {
+	SmallPacket small;
+	SimplePacket full;
+	uint8_t data[SMALL + 1] = {0};
+
+	benchCheck(small.getCapacity() == SMALL && full.getCapacity() == SP_MAX_DATA_LEN, "packet capacity");
+	benchCheck(sizeof(SmallPacket) < sizeof(SimplePacket), "small packets are smaller");
+	benchCheck(small.setData(data, SMALL) && !small.addData((uint8_t) 1) && small.getDataLength() == SMALL, "payload limited to the capacity");
+	benchCheck(!small.setData(data, SMALL + 1), "longer payload rejected");
+
+	typedef SimpleMessage<uint16_t, uint32_t> Sample;
+	Sample::write(small, 0x1234, 0x56789ABCUL);
+	uint16_t id;
+	uint32_t value;
+	benchCheck(Sample::read(small, id, value) && id == 0x1234 && value == 0x56789ABCUL, "message in a small packet");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkCopies() {
+	SimplePacket full;
+	SmallPacket small;
+
+	full.setType(0x21);
+	benchFillPacket(full, SMALL, 3);
+	small = full;
+	benchCheck(small.getType() == 0x21 && small.getDataLength() == SMALL
+			&& memcmp(small.getData(), full.getData(), SMALL) == 0, "copy into a small packet");
+
+	benchFillPacket(full, SMALL + 1);
+	benchCheck(!small.copyFrom(full) && small.getDataLength() == SMALL, "too long to copy");
+	small = full;
+	benchCheck(small.getDataLength() == 0, "assignment of a too long packet clears it");
+
+	benchFillPacket(small, 5, 7);
+	SimplePacket back(small);
+	SmallPacket same(small);
+	benchCheck(back.getDataLength() == 5 && memcmp(back.getData(), small.getData(), 5) == 0
+			&& same.getDataLength() == 5 && memcmp(same.getData(), small.getData(), 5) == 0, "copies of a small packet");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkReceive(bool bulkRead) {
+	// A small packet receives short frames and rejects the longer ones
+	MockStream wire;
+	SimpleCommLink sender(wire, 9);
+	SimplePacket tx;
+	uint8_t bytes[3 * SP_BUFFER_SIZE];
+	size_t total = 0;
+	benchFillPacket(tx, SMALL, 1);
+	sender.send(tx, 1, 0x10);
+	total += wire.readBytes(bytes + total, SP_BUFFER_SIZE);
+	benchFillPacket(tx, BENCH_LEN(40), 2);
+	sender.send(tx, 1, 0x11);
+	total += wire.readBytes(bytes + total, SP_BUFFER_SIZE);
+	benchFillPacket(tx, 2, 3);
+	sender.send(tx, 1, 0x12);
+	total += wire.readBytes(bytes + total, SP_BUFFER_SIZE);
+
+	MockStream stream;
+	SimpleCommLink link(stream, 1);
+	link.setBulkRead(bulkRead);
+	SmallPacket rx;
+	stream.write(bytes, total);
+	uint8_t types[3];
+	uint8_t received = 0;
+	while (stream.available() && received < sizeof(types)) {
+		if (link.receive(rx)) {
+			types[received++] = rx.getType();
+		}
+	}
+	benchCheck(received == 2 && types[0] == 0x10 && types[1] == 0x12 && rx.getDataLength() == 2, "small packet skips long frames");
+#if SP_STATS
+	benchCheck(link.getStats().lengthErrors >= 1, "long frames are length errors");
+#endif
+
+	// A partial frame too long for the next packet is dropped
+	SimplePacket full;
+	benchFillPacket(tx, BENCH_LEN(40), 4);
+	sender.send(tx, 1, 0x13);
+	size_t len = wire.readBytes(bytes, SP_BUFFER_SIZE);
+	stream.write(bytes, 10);
+	link.receive(full);
+	stream.write(bytes + 10, len - 10);
+	benchFillPacket(tx, 2, 5);
+	sender.send(tx, 1, 0x14);
+	len = wire.readBytes(bytes, SP_BUFFER_SIZE);
+	stream.write(bytes, len);
+	benchCheck(link.receive(rx) && rx.getType() == 0x14, "partial frame too long for the packet");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkQueues() {
+	MockStream stream;
+	SimpleCommLink link(stream, 1);
+	SimpleCommTxQueueBuffer<2, SMALL> queue(link);
+	SimpleCommReceiverBuffer<2, SMALL> receiver(link);
+	SimplePacket tx;
+
+	benchFillPacket(tx, SMALL + 1);
+	benchCheck(!queue.send(tx, 1, 0x10) && queue.isEmpty(), "small queue rejects long packets");
+	benchFillPacket(tx, SMALL, 1);
+	benchCheck(queue.send(tx, 1, 0x10), "small queue");
+	benchFillPacket(tx, 3, 2);
+	benchCheck(queue.send(tx, 1, 0x11), "small queue second slot");
+	benchCheck(queue.poll() == 2 && receiver.poll() == 2, "small queue to small receiver");
+	SimplePacketBase *packet = receiver.peek();
+	benchCheck(packet && packet->getType() == 0x10 && packet->getDataLength() == SMALL, "small receiver first slot");
+	receiver.pop();
+	packet = receiver.peek();
+	benchCheck(packet && packet->getType() == 0x11 && packet->getDataLength() == 3, "small receiver second slot");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <sp_len_t N>
+static void benchBurst(const char *name, sp_len_t len) {
+	// Burst of short frames received into a ring of N byte packets, and
+	// copied out as a cache of the last value of each slave would
+	MockStream stream(BURST * SP_BUFFER_SIZE);
+	SimpleCommLink link(stream);
+	link.setBulkRead(true);
+	SimplePacket tx;
+	benchFillPacket(tx, len);
+	link.send(tx, 1, 0x10);
+	uint8_t frame[SP_BUFFER_SIZE];
+	size_t frameLen = stream.available();
+	stream.readBytes(frame, frameLen);
+
+	SimpleCommReceiverBuffer<BURST, N> receiver(link);
+	BasicSimplePacket<N> cache[BURST];
+
+	unsigned long iterations = benchIterations(frameLen * BURST);
+	unsigned long received = 0;
+	double ns = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		stream.clear();
+		for (uint8_t j = 0; j < BURST; ++j) {
+			stream.write(frame, frameLen);
+		}
+
+		BenchTimer timer;
+		receiver.poll();
+		for (uint8_t j = 0; receiver.available(); ++j, receiver.pop()) {
+			cache[j] = *receiver.peek();
+			++received;
+		}
+		ns += timer.elapsedNs();
+	}
+
+	benchCheck(received == iterations * BURST && cache[BURST - 1].getDataLength() == len, "every frame of the burst is cached");
+	benchReport(name, len, received, received * frameLen, ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchPacketSize() {
+	checkCapacity();
+	checkCopies();
+	checkReceive(false);
+	checkReceive(true);
+	checkQueues();
+
+	benchSection("Packet capacity");
+	benchNote("%-28s bytes per packet: %u (8), %u (%u), %u (%u); receiver of 8: %u -> %u", "",
+			(unsigned) sizeof(BasicSimplePacket<8>), (unsigned) sizeof(BasicSimplePacket<MEDIUM>), (unsigned) MEDIUM,
+			(unsigned) sizeof(SimplePacket), (unsigned) SP_MAX_DATA_LEN,
+			(unsigned) sizeof(SimpleCommReceiverBuffer<BURST>), (unsigned) sizeof(SimpleCommReceiverBuffer<BURST, SMALL>));
+	benchBurst<SP_MAX_DATA_LEN>("burst+cache (full packets)", 2);
+	benchBurst<SMALL>("burst+cache (8 byte packets)", 2);
+	benchBurst<SP_MAX_DATA_LEN>("burst+cache (full packets)", SMALL);
+	benchBurst<SMALL>("burst+cache (8 byte packets)", SMALL);
+}
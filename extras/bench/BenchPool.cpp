@@ -0,0 +1,298 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommPacketQueue.h>
+#include <SimpleCommTxQueue.h>
+
+#include <thread>
+
+#define POOL 4
+#define BURST 8
+
+// Stream without availableForWrite(), as the Print default
+class PlainStream : public MockStream {
+public:
+	int availableForWrite() { return 0; }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkReferences() {
+	SimpleCommPacketPoolBuffer<POOL, 16> pool;
+	const SimpleCommPoolStats &stats = pool.getStats();
+
+	SimpleCommPacketRef refs[POOL];
+	for (uint8_t i = 0; i < POOL; ++i) {
+		refs[i] = pool.alloc();
+	}
+	benchCheck(!refs[POOL - 1].isNull() && pool.available() == 0 && stats.used == POOL, "pool allocation");
+	benchCheck(pool.alloc().isNull() && stats.failures == 1, "empty pool");
+	benchCheck(refs[0]->getCapacity() == 16 && refs[0]->getDataLength() == 0, "pool packet capacity");
+
+	// Copies share the packet, which goes back with the last of them
+	refs[0]->setData("shared");
+	SimpleCommPacketRef copy(refs[0]);
+	SimpleCommPacketRef other;
+	other = copy;
+	benchCheck(copy.get() == refs[0].get() && refs[0].refs() == 3, "shared references");
+	refs[0].release();
+	copy = SimpleCommPacketRef();
+	benchCheck(pool.available() == 0 && other.refs() == 1 && strcmp(other->getString(), "shared") == 0, "packet kept by its last reference");
+	other.release();
+	benchCheck(pool.available() == 1 && stats.used == POOL - 1 && stats.peak == POOL, "packet back to the pool");
+
+	SimpleCommPacketRef again = pool.alloc();
+	benchCheck(!again.isNull() && again->getDataLength() == 0, "reused packet is cleared");
+	for (uint8_t i = 0; i < POOL; ++i) {
+		refs[i].release();
+	}
+	again.release();
+	pool.resetStats();
+	benchCheck(pool.available() == POOL && stats.peak == 0 && stats.failures == 0, "pool statistics reset");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkBroadcast() {
+	// Received packets go out by two links without being copied
+	MockStream wire;
+	SimpleCommLink sender(wire, 9);
+	SimplePacket tx;
+	uint8_t frames[3 * SP_BUFFER_SIZE];
+	size_t total = 0;
+	for (uint8_t i = 0; i < 3; ++i) {
+		benchFillPacket(tx, 10 + i, i);
+		sender.send(tx, 0, 0x10 + i);
+		total += wire.readBytes(frames + total, SP_BUFFER_SIZE);
+	}
+
+	MockStream in;
+	MockStream outA;
+	MockStream outB;
+	SimpleCommLink link(in);
+	SimpleCommLink linkA(outA);
+	SimpleCommLink linkB(outB);
+	SimpleCommPacketPoolBuffer<POOL> pool;
+	SimpleCommPacketQueueBuffer<2> received;
+	SimpleCommPacketQueueBuffer<4> queueA;
+	SimpleCommPacketQueueBuffer<4> queueB;
+
+	in.write(frames, total);
+	benchCheck(received.receive(link, pool) == 2 && received.isFull(), "queue stops when full");
+	for (const SimpleCommPacketRef *packet; (packet = received.peek()) != NULL; received.pop()) {
+		queueA.forward(*packet);
+		queueB.forward(*packet);
+	}
+	benchCheck(pool.getStats().used == 2 && queueA.available() == 2, "packets shared by the queues");
+	benchCheck(received.receive(link, pool) == 1 && queueA.forward(*received.peek()) && queueB.forward(*received.peek()), "last packet");
+	received.pop();
+
+	benchCheck(queueA.transmit(linkA) == 3 && queueB.transmit(linkB) == 3, "queues transmitted");
+	uint8_t bytes[3 * SP_BUFFER_SIZE];
+	benchCheck(outA.readBytes(bytes, sizeof(bytes)) == total && memcmp(bytes, frames, total) == 0, "frames sent unchanged by link A");
+	benchCheck(outB.readBytes(bytes, sizeof(bytes)) == total && memcmp(bytes, frames, total) == 0, "frames sent unchanged by link B");
+	// The receiving queue keeps a packet for the next frame
+	benchCheck(pool.available() == POOL - 1, "packets back to the pool once sent");
+
+	// A frame cut by a short write goes on with the next call
+	SimpleCommPacketRef packet = pool.alloc();
+	benchFillPacket(*packet, BENCH_LEN(20));
+	packet->setDestination(2);
+	queueA.push(packet);
+	packet.release();
+	MockStream narrow(16);
+	SimpleCommLink linkN(narrow);
+	uint8_t sent = queueA.transmit(linkN);
+	size_t first = narrow.readBytes(bytes, sizeof(bytes));
+	sent += queueA.transmit(linkN);
+	size_t second = narrow.readBytes(bytes + first, sizeof(bytes) - first);
+	MockStream wide;
+	SimpleCommLink rx(wide, 2);
+	SimplePacket check;
+	wide.write(bytes, first + second);
+	benchCheck(sent == 1 && first == 16 && rx.receive(check) && check.getDataLength() == BENCH_LEN(20), "frame split across transmits");
+	benchCheck(pool.available() == POOL - 1, "split frame packet released");
+
+	// Streams without availableForWrite() are written up to the write limit
+	packet = pool.alloc();
+	benchFillPacket(*packet, BENCH_LEN(20));
+	packet->setDestination(2);
+	SimpleCommPacketQueueBuffer<1> plainQueue;
+	plainQueue.push(packet);
+	PlainStream plain;
+	SimpleCommLink linkP(plain);
+	SimpleCommLink rxP(plain, 2);
+	benchCheck(plainQueue.transmit(linkP) == 1 && rxP.receive(check) && check.getDataLength() == BENCH_LEN(20), "default write limit");
+}
+
+#if SP_STATS
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkExport() {
+	SimpleCommPacketPoolBuffer<POOL> pool;
+	MockStream stream;
+	SimpleCommLink link(stream);
+	SimplePacket packet;
+	SimpleCommStats stats;
+	SimpleCommPoolStats poolStats;
+
+	// The counters, their 3 count bytes and the 4 pool counters don't fit a small SP_MAX_DATA_LEN
+	if (sizeof(SimpleCommStats) + 3 + 4 * 4 > SP_MAX_DATA_LEN) {
+		link.setPool(&pool);
+		benchCheck(!link.exportStats(packet), "pool occupancy too long for the packet");
+		return;
+	}
+
+	benchCheck(link.exportStats(packet) && SimpleCommLink::importStats(packet, stats, &poolStats)
+			&& poolStats.size == 0, "no pool exported");
+
+	SimpleCommPacketRef a = pool.alloc();
+	SimpleCommPacketRef b = pool.alloc();
+	b.release();
+	link.setPool(&pool);
+	benchCheck(link.exportStats(packet) && SimpleCommLink::importStats(packet, stats, &poolStats)
+			&& poolStats.size == POOL && poolStats.used == 1 && poolStats.peak == 2 && poolStats.failures == 0, "pool occupancy exported");
+	benchCheck(SimpleCommLink::importStats(packet, stats), "pool occupancy ignored");
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkConcurrency() {
+	// A producer thread stands for an interrupt filling a queue the main
+	// loop drains: the queue and the counts take no locks
+	static const unsigned long COUNT = 50000;
+	SimpleCommPacketPoolBuffer<POOL, 8> pool;
+	SimpleCommPacketQueueBuffer<2> queue;
+	unsigned long errors = 0;
+
+	std::thread producer([&pool, &queue]() {
+		for (unsigned long i = 0; i < COUNT; ) {
+			SimpleCommPacketRef packet = pool.alloc();
+			if (packet.isNull()) {
+				std::this_thread::yield();
+				continue;
+			}
+			packet->setData((SP_ULONG) i);
+			while (!queue.push(packet)) {
+				std::this_thread::yield();
+			}
+			++i;
+		}
+	});
+
+	SimpleCommPacketRef last;
+	for (unsigned long i = 0; i < COUNT; ) {
+		const SimpleCommPacketRef *packet = queue.peek();
+		if (!packet) {
+			std::this_thread::yield();
+			continue;
+		}
+		errors += (*packet)->getULong() != i;
+		// Kept a while, so the producer finds the pool short at times
+		last = *packet;
+		queue.pop();
+		++i;
+	}
+	producer.join();
+	last.release();
+
+	benchCheck(errors == 0 && pool.available() == POOL, "packets passed between threads");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void fillBurst(MockStream &stream, const uint8_t *frame, size_t frameLen) {
+	stream.clear();
+	for (uint8_t i = 0; i < BURST; ++i) {
+		stream.write(frame, frameLen);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchBroadcast(sp_len_t len, bool pooled) {
+	// Each received packet goes out by two links
+	MockStream in(BURST * SP_BUFFER_SIZE);
+	MockStream outA(BURST * SP_BUFFER_SIZE);
+	MockStream outB(BURST * SP_BUFFER_SIZE);
+	SimpleCommLink link(in);
+	SimpleCommLink linkA(outA);
+	SimpleCommLink linkB(outB);
+	link.setBulkRead(true);
+
+	SimplePacket tx;
+	benchFillPacket(tx, len);
+	link.send(tx, 1, 0x10);
+	uint8_t frame[SP_BUFFER_SIZE];
+	size_t frameLen = in.available();
+	in.readBytes(frame, frameLen);
+
+	SimplePacket rx;
+	SimpleCommTxQueueBuffer<BURST> txA(linkA);
+	SimpleCommTxQueueBuffer<BURST> txB(linkB);
+	SimpleCommPacketPoolBuffer<BURST> pool;
+	SimpleCommPacketQueueBuffer<BURST> received;
+	SimpleCommPacketQueueBuffer<BURST> queueA;
+	SimpleCommPacketQueueBuffer<BURST> queueB;
+
+	unsigned long iterations = benchIterations(frameLen * BURST * 3);
+	unsigned long sent = 0;
+	double ns = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		fillBurst(in, frame, frameLen);
+		outA.clear();
+		outB.clear();
+
+		BenchTimer timer;
+		if (pooled) {
+			received.receive(link, pool);
+			for (const SimpleCommPacketRef *packet; (packet = received.peek()) != NULL; received.pop()) {
+				queueA.forward(*packet);
+				queueB.forward(*packet);
+			}
+			sent += queueA.transmit(linkA) + queueB.transmit(linkB);
+		}
+		else {
+			// Each queue takes a copy of the packet
+			while (link.receive(rx)) {
+				txA.forward(rx);
+				txB.forward(rx);
+			}
+			sent += txA.poll() + txB.poll();
+		}
+		ns += timer.elapsedNs();
+	}
+
+	benchCheck(sent == 2 * BURST * iterations, "every packet is sent by both links");
+	benchReport(pooled ? "broadcast (pool)" : "broadcast (copies)", len, sent / 2, sent * frameLen, ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchPool() {
+	checkReferences();
+	checkBroadcast();
+#if SP_STATS
+	checkExport();
+#endif
+	checkConcurrency();
+
+	benchSection("Packet pool (bulk read)");
+	benchNote("%-28s RAM: 2 queues of %u copies %u bytes, pool of %u and 3 queues %u bytes", "",
+			BURST, (unsigned) (2 * sizeof(SimpleCommTxQueueBuffer<BURST>)),
+			BURST, (unsigned) (sizeof(SimpleCommPacketPoolBuffer<BURST>) + 3 * sizeof(SimpleCommPacketQueueBuffer<BURST>)));
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchBroadcast(benchPayloadSizes[i], false);
+		benchBroadcast(benchPayloadSizes[i], true);
+	}
+}
@@ -0,0 +1,122 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommReceiver.h>
+
+#define BURST 8
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkReceiverOrder() {
+	MockStream stream;
+	SimpleCommLink link(stream);
+	SimplePacket tx;
+	SimpleCommReceiverBuffer<4> receiver(link);
+
+	// 6 frames for 4 slots, the last one split across polls
+	for (uint8_t i = 0; i < 6; ++i) {
+		benchFillPacket(tx, i * 3, i);
+		link.send(tx, 1, i);
+	}
+	uint8_t bytes[256];
+	size_t count = stream.available();
+	stream.readBytes(bytes, count);
+	stream.write(bytes, count - 3);
+
+	benchCheck(receiver.poll() == 4 && receiver.isFull(), "receiver stops when full");
+	for (uint8_t i = 0; i < 2; ++i) {
+		benchCheck(receiver.peek()->getType() == i && receiver.peek()->getDataLength() == i * 3, "receiver order");
+		receiver.pop();
+	}
+	benchCheck(receiver.poll() == 1 && receiver.available() == 3, "receiver resumes after pop");
+	stream.write(bytes + count - 3, 3);
+	benchCheck(receiver.poll() == 1 && receiver.available() == 4, "receiver completes a split frame");
+	for (uint8_t i = 2; i < 6; ++i) {
+		benchCheck(receiver.peek()->getType() == i && receiver.peek()->getDataLength() == i * 3, "receiver order after wrap");
+		receiver.pop();
+	}
+	benchCheck(receiver.peek() == NULL, "receiver drained");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void fillBurst(MockStream &stream, const uint8_t *frame, size_t frameLen) {
+	stream.clear();
+	for (uint8_t i = 0; i < BURST; ++i) {
+		stream.write(frame, frameLen);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchBurst(sp_len_t len, bool useReceiver) {
+	MockStream stream(BURST * SP_BUFFER_SIZE);
+	SimpleCommLink link(stream);
+	link.setBulkRead(true);
+	SimplePacket tx;
+	benchFillPacket(tx, len);
+	link.send(tx, 1, 0x10);
+	uint8_t frame[SP_BUFFER_SIZE];
+	size_t frameLen = stream.available();
+	stream.readBytes(frame, frameLen);
+
+	SimplePacket rx;
+	SimplePacket queue[BURST];
+	SimpleCommReceiverBuffer<BURST> receiver(link);
+
+	unsigned long iterations = benchIterations(frameLen * BURST);
+	unsigned long received = 0;
+	volatile uint8_t sink = 0;
+	double ns = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		fillBurst(stream, frame, frameLen);
+
+		BenchTimer timer;
+		if (useReceiver) {
+			receiver.poll();
+			for (SimplePacketBase *packet; (packet = receiver.peek()) != NULL; receiver.pop()) {
+				sink = sink + packet->getType();
+				++received;
+			}
+		}
+		else {
+			// What callers do today: loop on receive() and copy each packet out
+			uint8_t count = 0;
+			while (count < BURST && link.receive(rx)) {
+				queue[count++] = rx;
+			}
+			for (uint8_t j = 0; j < count; ++j) {
+				sink = sink + queue[j].getType();
+				++received;
+			}
+		}
+		ns += timer.elapsedNs();
+	}
+
+	benchCheck(received == iterations * BURST, "every frame of the burst is received");
+	benchReport(useReceiver ? "burst of 8 (receiver)" : "burst of 8 (receive+copy)", len, received, received * frameLen, ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchReceiver() {
+	checkReceiverOrder();
+
+	benchSection("Multi-packet receiver (bulk read)");
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchBurst(benchPayloadSizes[i], false);
+		benchBurst(benchPayloadSizes[i], true);
+	}
+}
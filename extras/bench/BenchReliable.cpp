@@ -0,0 +1,255 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommReliable.h>
+
+#include "SimLine.h"
+
+// 19200 bps, 8N1
+#define BYTE_TIME 521
+// Turnaround of an RS-485 slave
+#define LATENCY 2000UL
+#define STEP 250
+// Leaves room for the control byte with a small SP_MAX_DATA_LEN
+#define PAYLOAD (SP_MAX_DATA_LEN > 32 ? 32 : SP_MAX_DATA_LEN - 1)
+// Resend period of examples/RS485-Master
+#define APP_TIMEOUT 1000000UL
+
+// Master on address 1, slave on address 2, joined by a lossy line
+struct ReliableRig {
+	MockStream inA;
+	MockStream inB;
+	SimLine lineAB;
+	SimLine lineBA;
+	SimPort portA;
+	SimPort portB;
+	SimpleCommLink linkA;
+	SimpleCommLink linkB;
+	SimpleCommReliableBuffer<4> master;
+	SimpleCommReliableBuffer<4> slave;
+	// The master, or one that replaces it on the same link
+	SimpleCommReliable *sender;
+	SimplePacket rxA;
+	SimplePacket rxB;
+	unsigned long delivered;
+	bool intact;
+
+	ReliableRig(uint8_t lossAB, uint8_t lossBA) : inA(1 << 16), inB(1 << 16),
+			lineAB(inB, lossAB, BYTE_TIME, LATENCY), lineBA(inA, lossBA, BYTE_TIME, LATENCY),
+			portA(lineAB, inA), portB(lineBA, inB), linkA(portA, 1), linkB(portB, 2),
+			master(linkA), slave(linkB), sender(&master), delivered(0), intact(true) {
+		linkA.setClock(simClock);
+		linkB.setClock(simClock);
+		linkA.setTimeouts(3 * BYTE_TIME);
+		linkB.setTimeouts(3 * BYTE_TIME);
+	}
+
+	// One STEP of the simulation
+	void step() {
+		sender->poll();
+		lineAB.deliver();
+		while (slave.receive(rxB)) {
+			// benchFillPacket() payloads start with their seed
+			SimplePacket expected;
+			benchFillPacket(expected, PAYLOAD, *(const uint8_t*) rxB.getData());
+			intact = intact && rxB.getDataLength() == PAYLOAD && rxB.getSource() == 1
+					&& memcmp(rxB.getData(), expected.getData(), PAYLOAD) == 0;
+			++delivered;
+		}
+		lineBA.deliver();
+		while (sender->receive(rxA)) {
+		}
+		simNow += STEP;
+	}
+
+	void run(unsigned long duration) {
+		unsigned long end = simNow + duration;
+		while (simNow < end) {
+			step();
+		}
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkReliable() {
+	simNow = 0;
+	simSeed(1);
+	SimplePacket tx;
+
+	// Clean line: the timeout follows the round-trip time
+	{
+		ReliableRig rig(0, 0);
+		for (uint8_t i = 0; i < 20; ++i) {
+			benchFillPacket(tx, PAYLOAD, i);
+			benchCheck(rig.master.send(tx, 2, 0x10), "reliable send");
+			rig.run(200000UL);
+			benchCheck(!rig.master.isPending(2), "frame acknowledged");
+		}
+		benchCheck(rig.delivered == 20 && rig.intact, "frames delivered once, without their control byte");
+		benchCheck(rig.master.getStats().retransmissions == 0, "no retransmission on a clean line");
+		// A frame and its ACK: about 50 bytes and two turnarounds
+		benchCheck(rig.master.getTimeout(2) < 60 * BYTE_TIME + 2 * LATENCY + 10000UL, "timeout adapted to the round-trip time");
+
+		benchCheck(!rig.master.send(tx, 0), "broadcasts are refused");
+		benchFillPacket(tx, SP_MAX_DATA_LEN);
+		benchCheck(!rig.master.send(tx, 2), "no room for the control byte");
+		benchFillPacket(tx, PAYLOAD);
+		for (uint8_t i = 0; i < 4; ++i) {
+			rig.master.send(tx, 3 + i);
+		}
+		benchCheck(rig.master.pending() == 4 && !rig.master.send(tx, 2), "table full");
+		rig.master.clear();
+	}
+
+	// Lost ACKs: the frame is resent, delivered once, then given up
+	{
+		ReliableRig rig(0, 100);
+		rig.master.setRetries(2);
+		benchFillPacket(tx, PAYLOAD, 1);
+		rig.master.send(tx, 2, 0x10);
+		unsigned long dropped = 0;
+		for (unsigned long i = 0; i < 20000000UL / STEP; ++i) {
+			dropped += rig.master.poll();
+			rig.step();
+		}
+		benchCheck(rig.delivered == 1 && rig.slave.getStats().duplicates == 2, "duplicates dropped");
+		benchCheck(dropped == 1 && rig.master.getStats().failures == 1 && !rig.master.isPending(2), "frame given up");
+	}
+
+	// A lost frame followed by others is asked for again before the timeout,
+	// once the slave knows the sequence numbers of the master
+	{
+		ReliableRig rig(0, 0);
+		benchFillPacket(tx, PAYLOAD, 9);
+		rig.master.send(tx, 2, 0x10);
+		rig.run(200000UL);
+		rig.lineAB.corruptNext(1);
+		for (uint8_t i = 0; i < 3; ++i) {
+			benchFillPacket(tx, PAYLOAD, i);
+			rig.master.send(tx, 2, 0x10);
+		}
+		rig.run(300000UL);
+		benchCheck(rig.delivered == 4 && rig.intact && !rig.master.isPending(2), "lost frame recovered");
+		benchCheck(rig.slave.getStats().nacksSent == 1 && rig.master.getStats().retransmissions == 1, "recovered by a NACK");
+	}
+
+	// A master that restarts takes new sequence numbers, which may be among
+	// the last ones the slave received from it
+	{
+		ReliableRig rig(0, 0);
+		uint8_t first = simNow >> 4;
+		for (uint8_t i = 0; i < 20; ++i) {
+			benchFillPacket(tx, PAYLOAD, i);
+			rig.master.send(tx, 2, 0x10);
+			rig.run(200000UL);
+		}
+		while ((((simNow >> 4) - first) & SimpleCommReliable::SEQUENCE_MASK) != 5) {
+			simNow += 16;
+		}
+		SimpleCommReliableBuffer<4> restarted(rig.linkA);
+		rig.sender = &restarted;
+		for (uint8_t i = 0; i < 5; ++i) {
+			benchFillPacket(tx, PAYLOAD, 20 + i);
+			restarted.send(tx, 2, 0x10);
+			rig.run(200000UL);
+		}
+		benchCheck(rig.delivered == 25 && rig.intact && rig.slave.getStats().duplicates == 0, "frames of a restarted master");
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchDelivery(unsigned long count, uint8_t loss, bool reliable) {
+	simNow = 0;
+	simSeed(3);
+	ReliableRig rig(loss, loss);
+	SimpleCommLink &master = rig.linkA;
+	SimpleCommLink &slave = rig.linkB;
+	SimplePacket tx;
+	SimplePacket reply;
+
+	double totalLatency = 0;
+	unsigned long maxLatency = 0;
+	unsigned long duplicates = 0;
+	unsigned long resent = 0;
+	for (unsigned long i = 0; i < count; ++i) {
+		uint8_t seed = (uint8_t) i;
+		benchFillPacket(tx, PAYLOAD, seed);
+		unsigned long start = simNow;
+		if (reliable) {
+			rig.master.send(tx, 2, 0x10);
+			while (rig.master.isPending(2)) {
+				rig.step();
+			}
+		}
+		else {
+			// What examples/RS485-Master does: resend until the slave answers
+			master.send(tx, 2, 0x10);
+			unsigned long sentAt = simNow;
+			bool answered = false;
+			bool received = false;
+			while (!answered) {
+				if (simNow - sentAt >= APP_TIMEOUT) {
+					master.send(tx, 2, 0x10);
+					sentAt = simNow;
+					++resent;
+				}
+				rig.lineAB.deliver();
+				while (slave.receive(rig.rxB)) {
+					// The slave can't tell a resent request from a new one
+					duplicates += *(const uint8_t*) rig.rxB.getData() != seed || received;
+					received = true;
+					++rig.delivered;
+					reply.setData(*(const uint8_t*) rig.rxB.getData());
+					slave.send(reply, 1, 0x11);
+				}
+				rig.lineBA.deliver();
+				while (master.receive(rig.rxA)) {
+					answered = answered || rig.rxA.getUChar() == seed;
+				}
+				simNow += STEP;
+			}
+		}
+		unsigned long latency = simNow - start;
+		totalLatency += latency;
+		if (latency > maxLatency) {
+			maxLatency = latency;
+		}
+	}
+	if (reliable) {
+		duplicates = rig.delivered - count;
+		resent = rig.master.getStats().retransmissions;
+	}
+
+	benchNote("%-22s loss %2u%%: %6.1f ms avg, %7.1f ms max, %4lu resent, %3lu duplicates", reliable ? "reliable (RTT timeout)" : "app resend every 1 s",
+			loss, totalLatency / count / 1000, maxLatency / 1000.0, resent, duplicates);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchReliable() {
+	checkReliable();
+
+	unsigned long count = benchQuick ? 200 : 1000;
+	benchSection("Reliable delivery (19200 bps, simulated)");
+	benchNote("%lu requests of %u bytes, one at a time, frames lost both ways", count, PAYLOAD);
+	static const uint8_t losses[] = {0, 2, 10};
+	for (uint8_t i = 0; i < sizeof(losses); ++i) {
+		benchDelivery(count, losses[i], false);
+		benchDelivery(count, losses[i], true);
+	}
+}
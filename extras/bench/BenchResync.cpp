@@ -0,0 +1,159 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <vector>
+
+static uint32_t seed;
+
+static uint32_t random32() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void fuzz(double errorRate, bool resync, bool bulkRead) {
+	const uint32_t frames = benchQuick ? 2000 : 20000;
+
+	// Every frame carries its own index, so received frames can be verified
+	MockStream wire(1 << 24);
+	SimpleCommLink sender(wire, 1);
+	SimplePacket tx;
+	std::vector<bool> intact(frames, true);
+	std::vector<uint8_t> bytes;
+	seed = 0x12345678;
+	for (uint32_t i = 0; i < frames; ++i) {
+		sp_len_t len = 4 + random32() % 61;
+		tx.setData(&i, sizeof(i));
+		for (uint8_t j = sizeof(i); j < len; ++j) {
+			tx.addData((SP_UCHAR) (i + j));
+		}
+		sender.send(tx, 2, (uint8_t) i);
+
+		// Half of the errors corrupt a byte, the other half lose it (e.g. UART overrun)
+		uint8_t frame[SP_BUFFER_SIZE];
+		size_t frameLen = wire.readBytes(frame, sizeof(frame));
+		for (size_t j = 0; j < frameLen; ++j) {
+			if (random32() < errorRate * 4294967296.0) {
+				intact[i] = false;
+				if (random32() & 1) {
+					continue;
+				}
+				frame[j] ^= 1 + random32() % 255;
+			}
+			bytes.push_back(frame[j]);
+		}
+	}
+
+	MockStream stream(1 << 24);
+	SimpleCommLink link(stream, 2);
+	link.setResync(resync);
+	link.setBulkRead(bulkRead);
+	SimplePacket rx;
+	uint32_t good = 0;
+	uint32_t recovered = 0;
+	uint32_t bad = 0;
+	size_t offset = 0;
+	BenchTimer timer;
+	while (offset < bytes.size()) {
+		size_t chunk = 1 + random32() % 32;
+		if (chunk > bytes.size() - offset) {
+			chunk = bytes.size() - offset;
+		}
+		stream.write(&bytes[offset], chunk);
+		offset += chunk;
+
+		while (link.receive(rx)) {
+			uint32_t index;
+			memcpy(&index, rx.getData(), sizeof(index));
+			bool valid = index < frames && rx.getType() == (uint8_t) index;
+			for (uint8_t j = sizeof(index); valid && j < rx.getDataLength(); ++j) {
+				valid = ((const uint8_t *) rx.getData())[j] == (uint8_t) (index + j);
+			}
+			if (!valid) {
+				++bad;
+			}
+			else if (intact[index]) {
+				++good;
+			}
+			else {
+				++recovered;
+			}
+		}
+	}
+	double ns = timer.elapsedNs();
+
+	uint32_t intactFrames = 0;
+	for (uint32_t i = 0; i < frames; ++i) {
+		intactFrames += intact[i];
+	}
+
+	if (errorRate == 0) {
+		benchCheck(good == frames, "every frame of a clean stream is received");
+	}
+	benchNote("%-28s error rate %.4f: %5u/%5u intact frames received, %u damaged accepted, %u invalid, %.0f ns/frame",
+			resync ? (bulkRead ? "resync (bulk read)" : "resync") : (bulkRead ? "no resync (bulk read)" : "no resync"),
+			errorRate, good, intactFrames, recovered, bad, ns / frames);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkResync() {
+	// A SYN inside a frame with a bad CRC starts the next frame
+	MockStream stream;
+	SimpleCommLink link(stream);
+	SimplePacket tx;
+	SimplePacket rx;
+	for (uint8_t bulkRead = 0; bulkRead < 2; ++bulkRead) {
+		link.setBulkRead(bulkRead);
+
+		benchFillPacket(tx, BENCH_LEN(30), 7);
+		link.send(tx, 1, 0x55);
+		uint8_t good[SP_BUFFER_SIZE];
+		size_t goodLen = stream.readBytes(good, sizeof(good));
+
+		// Truncated frame claiming 40 bytes, immediately followed by a good one
+		const sp_len_t claimed = BENCH_LEN(40);
+		uint8_t bytes[3 * SP_BUFFER_SIZE] = {SP_SYN_VALUE, (uint8_t) claimed, 1, 2, 3};
+		memcpy(bytes + 5, good, goodLen);
+		memset(bytes + 5 + goodLen, 0, claimed);
+		stream.write(bytes, 5 + goodLen + claimed);
+
+		bool received = false;
+		while (stream.available() && !received) {
+			received = link.receive(rx);
+		}
+		benchCheck(received && rx.getType() == 0x55 && rx.getDataLength() == tx.getDataLength()
+				&& memcmp(rx.getData(), tx.getData(), tx.getDataLength()) == 0, "frame inside a bad frame is recovered");
+		stream.clear();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchResync() {
+	checkResync();
+
+	benchSection("Resynchronisation on a corrupted stream");
+	static const double errorRates[] = {0, 0.0005, 0.002, 0.01};
+	for (uint8_t i = 0; i < sizeof(errorRates) / sizeof(errorRates[0]); ++i) {
+		fuzz(errorRates[i], false, false);
+		fuzz(errorRates[i], true, false);
+		fuzz(errorRates[i], true, true);
+	}
+}
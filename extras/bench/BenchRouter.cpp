@@ -0,0 +1,240 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommRouter.h>
+
+#define BURST 16
+
+// Port whose writes don't come back to it: frames arrive in in and leave in out
+class DuplexStream : public Stream {
+public:
+	explicit DuplexStream(size_t capacity = 4096) : in(capacity), out(capacity) {
+	}
+
+	size_t write(uint8_t c) { return out.write(c); }
+	size_t write(const uint8_t *buffer, size_t size) { return out.write(buffer, size); }
+	using Print::write;
+	int availableForWrite() { return out.availableForWrite(); }
+
+	int available() { return in.available(); }
+	int read() { return in.read(); }
+	int peek() { return in.peek(); }
+	size_t readBytes(char *buffer, size_t length) { return in.readBytes(buffer, length); }
+	using Stream::readBytes;
+
+public:
+	MockStream in;
+	MockStream out;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static size_t encodeFrame(uint8_t *frame, uint8_t source, uint8_t destination, sp_len_t len, uint8_t compression = 0) {
+	MockStream wire;
+	SimpleCommLink sender(wire, source);
+#ifdef SP_COMPRESSION
+	sender.setCompression(compression);
+#else
+	(void) compression;
+#endif
+	SimplePacket tx;
+	benchFillPacket(tx, len, destination);
+	sender.send(tx, destination, 0x30);
+	return wire.readBytes(frame, SP_BUFFER_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool sameBytes(MockStream &stream, const uint8_t *expected, size_t len) {
+	uint8_t bytes[4 * SP_BUFFER_SIZE];
+	size_t count = stream.readBytes(bytes, sizeof(bytes));
+	return count == len && memcmp(bytes, expected, len) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkRoutes() {
+	DuplexStream field;
+	DuplexStream client;
+	DuplexStream panel;
+	SimpleCommLink fieldLink(field);
+	SimpleCommLink clientLink(client);
+	SimpleCommLink panelLink(panel);
+	SimpleCommRouterBuffer<3, 4> router;
+
+	uint8_t fieldPort = router.addPort(fieldLink);
+	uint8_t clientPort = router.addPort(clientLink);
+	uint8_t panelPort = router.addPort(panelLink);
+	benchCheck(panelPort == 2 && router.addPort(fieldLink) == SimpleCommRouter::NONE, "router ports");
+	benchCheck(!router.addRoute(0x20, 3), "route to a missing port");
+	router.addRoute(0x10, fieldPort, 0xF0);
+	router.addRoute(0x20, panelPort);
+	router.addRoute(0x00, clientPort, 0x00);
+
+	uint8_t toPanel[SP_BUFFER_SIZE];
+	uint8_t toClient[SP_BUFFER_SIZE];
+	uint8_t toField[SP_BUFFER_SIZE];
+	uint8_t back[SP_BUFFER_SIZE];
+	uint8_t broadcast[SP_BUFFER_SIZE];
+	size_t toPanelLen = encodeFrame(toPanel, 0x11, 0x20, 12);
+	size_t toClientLen = encodeFrame(toClient, 0x11, 0x05, 0);
+	size_t backLen = encodeFrame(back, 0x11, 0x12, 3);
+	size_t broadcastLen = encodeFrame(broadcast, 0x11, 0x00, 5);
+	size_t toFieldLen = encodeFrame(toField, 0x40, 0x13, SP_MAX_DATA_LEN);
+
+	// Fed byte by byte on two ports at once
+	for (size_t i = 0; i < toPanelLen || i < toFieldLen; ++i) {
+		if (i < toPanelLen) {
+			field.in.write(toPanel[i]);
+		}
+		if (i < toFieldLen) {
+			client.in.write(toField[i]);
+		}
+		router.poll();
+	}
+	field.in.write(toClient, toClientLen);
+	field.in.write(back, backLen);
+	field.in.write(broadcast, broadcastLen);
+	router.poll();
+
+	uint8_t expected[2 * SP_BUFFER_SIZE];
+	memcpy(expected, toPanel, toPanelLen);
+	memcpy(expected + toPanelLen, broadcast, broadcastLen);
+	benchCheck(sameBytes(panel.out, expected, toPanelLen + broadcastLen), "frames forwarded unchanged");
+	memcpy(expected, toClient, toClientLen);
+	memcpy(expected + toClientLen, broadcast, broadcastLen);
+	benchCheck(sameBytes(client.out, expected, toClientLen + broadcastLen), "default route and broadcast");
+	benchCheck(sameBytes(field.out, toField, toFieldLen), "route by address mask");
+
+	const SimpleCommRouterStats &stats = router.getStats();
+	benchCheck(stats.forwarded == 3 && stats.broadcasts == 1 && stats.unroutable == 1 && stats.drops == 0, "router statistics");
+	benchCheck(router.getRoute(0)->packets == 1 && router.getRoute(0)->bytes == SP_MAX_DATA_LEN
+			&& router.getRoute(1)->bytes == 12 && router.getRoute(2)->packets == 1, "route counters");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkQueues() {
+	DuplexStream field;
+	DuplexStream client;
+	SimpleCommLink fieldLink(field);
+	SimpleCommLink clientLink(client);
+	SimpleCommTxQueueBuffer<2> clientQueue(clientLink);
+	SimpleCommRouterBuffer<2, 1> router;
+	router.addPort(fieldLink);
+	router.addRoute(0x05, router.addPort(clientLink, &clientQueue));
+
+	// The third frame of a burst doesn't fit the queue
+	uint8_t frame[SP_BUFFER_SIZE];
+	size_t frameLen = encodeFrame(frame, 0x11, 0x05, BENCH_LEN(40));
+	for (uint8_t i = 0; i < 3; ++i) {
+		field.in.write(frame, frameLen);
+	}
+	benchCheck(router.poll() == 2 && router.getStats().drops == 1 && router.getRoute(0)->drops == 1, "full port queue");
+
+	uint8_t expected[2 * SP_BUFFER_SIZE];
+	memcpy(expected, frame, frameLen);
+	memcpy(expected + frameLen, frame, frameLen);
+	benchCheck(sameBytes(client.out, expected, 2 * frameLen), "queued frames forwarded unchanged");
+	benchCheck(clientLink.getStats().packetsSent == 2, "queued frames counted as sent");
+}
+
+#ifdef SP_COMPRESSION
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkCompressed() {
+	// receive() decompresses in place: the frame is encoded again, keeping its source
+	DuplexStream field;
+	DuplexStream client;
+	SimpleCommLink fieldLink(field);
+	SimpleCommLink clientLink(client);
+	SimpleCommTxQueueBuffer<2> clientQueue(clientLink);
+	SimpleCommRouterBuffer<3, 2> router;
+	router.addPort(fieldLink);
+	router.addRoute(0x05, router.addPort(clientLink));
+	router.addRoute(0x06, router.addPort(clientLink, &clientQueue));
+
+	SimplePacket tx;
+	tx.setData("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+	SimpleCommLink sender(field.in, 0x11);
+	sender.setCompression(16);
+	sender.send(tx, 0x05, 0x30);
+	sender.send(tx, 0x06, 0x31);
+	router.poll();
+
+	SimpleCommLink receiver(client.out);
+	SimplePacket rx;
+	for (uint8_t i = 0; i < 2; ++i) {
+		benchCheck(receiver.receive(rx) && rx.getSource() == 0x11 && rx.getType() == 0x30 + i
+				&& rx.getDataLength() == tx.getDataLength()
+				&& memcmp(rx.getData(), tx.getData(), tx.getDataLength()) == 0, "compressed frame forwarded");
+	}
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchForward(sp_len_t len, bool useRouter) {
+	uint8_t frame[SP_BUFFER_SIZE];
+	size_t frameLen = encodeFrame(frame, 0x11, 0x05, len);
+
+	DuplexStream field(BURST * SP_BUFFER_SIZE);
+	DuplexStream client(BURST * SP_BUFFER_SIZE);
+	SimpleCommLink fieldLink(field);
+	SimpleCommLink clientLink(client);
+	fieldLink.setBulkRead(true);
+	SimpleCommRouterBuffer<2, 1> router;
+	router.addPort(fieldLink);
+	router.addRoute(0x05, router.addPort(clientLink));
+	SimplePacket packet;
+
+	unsigned long iterations = benchIterations(frameLen * BURST);
+	double ns = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		for (uint8_t j = 0; j < BURST; ++j) {
+			field.in.write(frame, frameLen);
+		}
+		client.out.clear();
+
+		BenchTimer timer;
+		if (useRouter) {
+			router.poll();
+		}
+		else {
+			// What gateways do today: receive, then send again (the source becomes the gateway's)
+			while (fieldLink.receive(packet)) {
+				clientLink.send(packet, packet.getDestination());
+			}
+		}
+		ns += timer.elapsedNs();
+	}
+
+	unsigned long forwarded = clientLink.getStats().packetsSent;
+	benchCheck(forwarded == iterations * BURST, "every frame is forwarded");
+	benchReport(useRouter ? "gateway (router)" : "gateway (receive+send)", len, forwarded, forwarded * frameLen, ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchRouter() {
+	checkRoutes();
+	checkQueues();
+#ifdef SP_COMPRESSION
+	checkCompressed();
+#endif
+
+	benchSection("Router (bulk read)");
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchForward(benchPayloadSizes[i], false);
+		benchForward(benchPayloadSizes[i], true);
+	}
+}
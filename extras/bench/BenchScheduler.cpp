@@ -0,0 +1,256 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommScheduler.h>
+
+#include "SimLine.h"
+
+#include <vector>
+
+// 19200 bps, 8N1
+#define BYTE_TIME 521
+#define STEP 250
+#define SLAVES 32
+#define REPLY_LEN 16
+// Timeout of the hand-written round-robin
+#define FIXED_TIMEOUT 100000UL
+
+// RS-485 bus: the master on address 0, slaves 1 to SLAVES answering after
+// 1 to 8 ms, some of them dead
+struct SchedulerBus {
+	MockStream inMaster;
+	MockStream inSlaves;
+	SimLine lineDown;
+	SimLine lineUp;
+	SimPort portMaster;
+	SimpleCommLink master;
+	SimpleCommLink slaves;
+	SimpleCommLink *replies[SLAVES + 1];
+	SimplePacket rxMaster;
+	SimplePacket rxSlaves;
+	SimplePacket reply;
+	bool alive[SLAVES + 1];
+	std::vector<std::pair<unsigned long, uint8_t> > pending;
+
+	SchedulerBus() : inMaster(1 << 16), inSlaves(1 << 16),
+			lineDown(inSlaves, 0, BYTE_TIME, 0), lineUp(inMaster, 0, BYTE_TIME, 0),
+			portMaster(lineDown, inMaster), master(portMaster, 0), slaves(inSlaves, 0) {
+		master.setClock(simClock);
+		for (uint8_t i = 1; i <= SLAVES; ++i) {
+			replies[i] = new SimpleCommLink(lineUp, i);
+			alive[i] = i % 8 != 7;
+		}
+		benchFillPacket(reply, REPLY_LEN);
+	}
+
+	~SchedulerBus() {
+		for (uint8_t i = 1; i <= SLAVES; ++i) {
+			delete replies[i];
+		}
+	}
+
+	static unsigned long delay(uint8_t address) {
+		return 1000UL + (address * 37 % 8) * 1000UL;
+	}
+
+	// The slaves side of one STEP
+	void step() {
+		lineDown.deliver();
+		while (slaves.receive(rxSlaves)) {
+			uint8_t address = rxSlaves.getDestination();
+			if (address >= 1 && address <= SLAVES && alive[address]) {
+				pending.push_back(std::make_pair(simNow + delay(address), address));
+			}
+		}
+		for (size_t i = 0; i < pending.size();) {
+			if (pending[i].first <= simNow) {
+				replies[pending[i].second]->send(reply, 0, 0x20);
+				pending.erase(pending.begin() + i);
+			}
+			else {
+				++i;
+			}
+		}
+		lineUp.deliver();
+	}
+};
+
+static unsigned long lastReply[SLAVES + 1];
+static double intervalSum[SLAVES + 1];
+static unsigned long intervalCount[SLAVES + 1];
+static unsigned long timeouts[SLAVES + 1];
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void resetCounters() {
+	memset(lastReply, 0, sizeof(lastReply));
+	memset(intervalSum, 0, sizeof(intervalSum));
+	memset(intervalCount, 0, sizeof(intervalCount));
+	memset(timeouts, 0, sizeof(timeouts));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void countReply(uint8_t address, bool answered) {
+	if (!answered) {
+		++timeouts[address];
+		return;
+	}
+	if (lastReply[address]) {
+		intervalSum[address] += simNow - lastReply[address];
+		++intervalCount[address];
+	}
+	lastReply[address] = simNow;
+}
+
+// Average time between two replies of the slaves from first to last
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static double averageInterval(uint8_t first, uint8_t last) {
+	double sum = 0;
+	unsigned long count = 0;
+	for (uint8_t i = first; i <= last; ++i) {
+		sum += intervalSum[i];
+		count += intervalCount[i];
+	}
+	return count ? sum / count : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool request(uint8_t address, SimplePacket &packet) {
+	packet.setData((SP_UCHAR) address);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void replied(uint8_t address, const SimplePacket *reply) {
+	countReply(address, reply && reply->getDataLength() == REPLY_LEN);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void runScheduler(SchedulerBus &bus, SimpleCommScheduler &scheduler, unsigned long duration) {
+	unsigned long end = simNow + duration;
+	while (simNow < end) {
+		scheduler.poll();
+		bus.step();
+		simNow += STEP;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkScheduler() {
+	simNow = 1;
+	resetCounters();
+	SchedulerBus bus;
+	SimpleCommSchedulerBuffer<SLAVES> scheduler(bus.master, request, replied);
+
+	// Slaves 1 to 4 every 250 ms first, the others as often as possible
+	for (uint8_t i = 1; i <= SLAVES; ++i) {
+		benchCheck(scheduler.add(i, i <= 4 ? 250000UL : 0, i <= 4), "slave added");
+	}
+	benchCheck(!scheduler.add(1, 0) && scheduler.count() == SLAVES, "slave added once");
+
+	runScheduler(bus, scheduler, 20000000UL);
+	bool online = true;
+	for (uint8_t i = 1; i <= SLAVES; ++i) {
+		online = online && scheduler.isOnline(i) == bus.alive[i];
+	}
+	benchCheck(online, "dead slaves go offline");
+	benchCheck(timeouts[7] >= 3 && timeouts[7] <= 3 + 20 / 5 + 1, "offline slaves polled every 5 s");
+	double fast = averageInterval(1, 4);
+	benchCheck(fast >= 250000 && fast < 280000, "high priority slaves keep their period");
+	benchCheck(averageInterval(5, 6) > 0 && scheduler.getStats().lateReplies == 0, "low priority slaves polled");
+
+	// A slave back on the bus is polled again within the offline period
+	bus.alive[7] = true;
+	runScheduler(bus, scheduler, 5500000UL);
+	benchCheck(scheduler.isOnline(7), "slave back online");
+
+	benchCheck(scheduler.remove(7) && !scheduler.remove(7) && scheduler.count() == SLAVES - 1, "slave removed");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchRoundRobin(unsigned long duration) {
+	simNow = 1;
+	resetCounters();
+	SchedulerBus bus;
+	SimplePacket packet;
+
+	// What a hand-written master does: next slave after a reply or a fixed timeout
+	unsigned long end = simNow + duration;
+	uint8_t address = 1;
+	unsigned long requests = 0;
+	while (simNow < end) {
+		request(address, packet);
+		bus.master.send(packet, address);
+		++requests;
+		unsigned long sentAt = simNow;
+		bool answered = false;
+		while (!answered && simNow - sentAt < FIXED_TIMEOUT) {
+			bus.step();
+			while (bus.master.receive(bus.rxMaster)) {
+				answered = answered || bus.rxMaster.getSource() == address;
+			}
+			simNow += STEP;
+		}
+		countReply(address, answered);
+		address = address == SLAVES ? 1 : address + 1;
+	}
+
+	unsigned long lost = 0;
+	for (uint8_t i = 1; i <= SLAVES; ++i) {
+		lost += timeouts[i];
+	}
+	benchNote("%-28s cycle %6.1f ms, %5.1f replies/s, lost to timeouts %3.0f%%", "round-robin, 100 ms timeout",
+			averageInterval(1, SLAVES) / 1000, (requests - lost) / (duration / 1e6), 100.0 * lost * FIXED_TIMEOUT / duration);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchScheduled(const char *name, unsigned long duration, uint8_t fast, unsigned long fastPeriod, unsigned long period) {
+	simNow = 1;
+	resetCounters();
+	SchedulerBus bus;
+	SimpleCommSchedulerBuffer<SLAVES> scheduler(bus.master, request, replied);
+	for (uint8_t i = 1; i <= SLAVES; ++i) {
+		scheduler.add(i, i <= fast ? fastPeriod : period, i <= fast);
+	}
+
+	// Steady state, once the dead slaves are known
+	runScheduler(bus, scheduler, 2000000UL);
+	resetCounters();
+	scheduler.resetStats();
+	runScheduler(bus, scheduler, duration);
+
+	const SimpleCommSchedulerStats &stats = scheduler.getStats();
+	benchNote("%-28s cycle %6.1f ms, %5.1f replies/s, lost to timeouts %3.0f%%, utilisation %3.0f%%", name,
+			averageInterval(fast + 1, SLAVES) / 1000, stats.replies / (duration / 1e6),
+			100.0 * stats.timeoutTime / duration, scheduler.getUtilisation() * 100);
+	if (fast) {
+		benchNote("%-28s period of slaves 1-%u %6.1f ms", "", fast, averageInterval(1, fast) / 1000);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchScheduler() {
+	checkScheduler();
+
+	unsigned long duration = benchQuick ? 10000000UL : 60000000UL;
+	benchSection("Master scheduler (19200 bps, 32 slaves, 4 dead, simulated)");
+	benchRoundRobin(duration);
+	benchScheduled("scheduler", duration, 0, 0, 0);
+	benchScheduled("scheduler, 4 every 250 ms", duration, 4, 250000UL, 0);
+	benchScheduled("scheduler, all every 1 s", duration, 0, 0, 1000000UL);
+}
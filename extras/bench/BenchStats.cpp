@@ -0,0 +1,184 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#if SP_STATS
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkCounters(bool bulkRead) {
+	static const uint8_t junk[] = {0x00, 0x55, 0xAA};
+	MockStream wire;
+	SimpleCommLink sender(wire, 9);
+	SimplePacket tx;
+	uint8_t bytes[4 * SP_BUFFER_SIZE];
+	size_t total = 0;
+
+	// Junk, a good frame, a frame for someone else and a corrupted one
+	memcpy(bytes, junk, sizeof(junk));
+	total += sizeof(junk);
+	benchFillPacket(tx, BENCH_LEN(20));
+	sender.send(tx, 1, 0x10);
+	size_t good = wire.readBytes(bytes + total, SP_BUFFER_SIZE);
+	total += good;
+	sender.send(tx, 2, 0x10);
+	total += wire.readBytes(bytes + total, SP_BUFFER_SIZE);
+	sender.send(tx, 1, 0x10);
+	size_t bad = wire.readBytes(bytes + total, SP_BUFFER_SIZE);
+	bytes[total + bad - 1] ^= 0x01;
+	total += bad;
+	benchCheck(sender.getStats().packetsSent == 3 && sender.getStats().bytesSent == total - sizeof(junk), "bytes sent");
+
+	MockStream stream;
+	SimpleCommLink link(stream, 1);
+	link.setBulkRead(bulkRead);
+	link.setResync(false);
+	SimplePacket rx;
+	stream.write(bytes, total);
+	uint8_t received = 0;
+	while (stream.available()) {
+		received += link.receive(rx);
+	}
+
+	const SimpleCommStats &stats = link.getStats();
+	benchCheck(received == 1 && stats.packetsReceived == 1 && stats.bytesReceived == total, "frames and bytes received");
+	benchCheck(stats.crcErrors == 1 && stats.addressRejects == 1
+			&& stats.bytesDropped == sizeof(junk) + bad, "error counters");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkExport() {
+	// A master polls the statistics of a slave
+	MockStream stream;
+	SimpleCommLink slave(stream, 2);
+	SimpleCommLink master(stream, 1);
+	SimplePacket packet;
+	SimplePacket reply;
+
+	// The counters and their 3 count bytes don't fit a small SP_MAX_DATA_LEN
+	if (sizeof(SimpleCommStats) + 3 > SP_MAX_DATA_LEN) {
+		benchCheck(!slave.exportStats(packet), "statistics too long for the packet");
+		return;
+	}
+
+	for (uint8_t i = 0; i < 3; ++i) {
+		benchFillPacket(packet, BENCH_LEN(10 * i));
+		master.send(packet, 2, 0x10);
+		slave.receive(packet);
+	}
+	stream.write((uint8_t) 0x55);
+	slave.receive(packet);
+
+	benchCheck(slave.exportStats(packet) && packet.getType() == SP_STATS_TYPE, "statistics exported");
+	slave.send(packet, 1);
+	SimpleCommStats remote;
+	benchCheck(master.receive(reply) && SimpleCommLink::importStats(reply, remote), "statistics imported");
+	const SimpleCommStats &local = slave.getStats();
+	// The export itself went out after the snapshot
+	benchCheck(remote.packetsReceived == 3 && remote.bytesDropped == 1 && remote.packetsSent == 0
+			&& remote.bytesReceived == local.bytesReceived
+			&& memcmp(&remote.crcErrors, &local.crcErrors, 6 * sizeof(uint32_t)) == 0, "remote statistics");
+
+	reply.setType(0x10);
+	benchCheck(!SimpleCommLink::importStats(reply, remote), "other packet types are not statistics");
+	reply.setType(SP_STATS_TYPE);
+	reply.setData((const void*) "\x0A\x01", 2);
+	benchCheck(!SimpleCommLink::importStats(reply, remote), "short statistics");
+}
+
+#ifdef SP_STATS_LATENCY
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkLatency() {
+	MockStream stream;
+	SimpleCommLink link(stream, 1);
+	SimplePacket tx;
+	SimplePacket rx;
+	benchFillPacket(tx, BENCH_LEN(30));
+
+	uint8_t calls = 0;
+	for (uint8_t i = 0; i < 10; ++i) {
+		link.receive(rx);
+		link.send(tx, 1, 0x10);
+		link.receive(rx);
+		++calls;
+	}
+
+	uint32_t timed = 0;
+	for (uint8_t i = 0; i < SP_STATS_LATENCY_BUCKETS; ++i) {
+		timed += link.getStats().receiveTime[i];
+	}
+	benchCheck(timed == calls, "only the calls that read bytes are timed");
+}
+#endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchCounters(sp_len_t len, bool bulkRead) {
+	MockStream stream(1 << 16);
+	SimpleCommLink link(stream, 1);
+	link.setBulkRead(bulkRead);
+	SimplePacket packet;
+	benchFillPacket(packet, len);
+	link.send(packet, 1, 0x10);
+	uint8_t frame[SP_BUFFER_SIZE];
+	size_t frameLen = stream.readBytes(frame, sizeof(frame));
+
+	unsigned long batch = (1 << 16) / frameLen;
+	unsigned long iterations = benchIterations(frameLen);
+	unsigned long received = 0;
+	double ns = 0;
+	while (received < iterations) {
+		stream.clear();
+		for (unsigned long i = 0; i < batch; ++i) {
+			stream.write(frame, frameLen);
+		}
+
+		BenchTimer timer;
+		while (link.receive(packet)) {
+			++received;
+		}
+		ns += timer.elapsedNs();
+	}
+
+#if !SP_STATS
+	const char *name = bulkRead ? "no stats (bulk read)" : "no stats";
+#elif defined(SP_STATS_LATENCY)
+	const char *name = bulkRead ? "stats+latency (bulk read)" : "stats+latency";
+#else
+	const char *name = bulkRead ? "stats (bulk read)" : "stats";
+#endif
+	benchReport(name, len, received, received * frameLen, ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchStats() {
+#if SP_STATS
+	checkCounters(false);
+	checkCounters(true);
+	checkExport();
+#ifdef SP_STATS_LATENCY
+	checkLatency();
+#endif
+#endif
+
+	benchSection("Statistics cost on decode");
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchCounters(benchPayloadSizes[i], false);
+	}
+	for (uint8_t i = 0; i < benchPayloadSizesCount; ++i) {
+		benchCounters(benchPayloadSizes[i], true);
+	}
+}
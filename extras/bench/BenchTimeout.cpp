@@ -0,0 +1,159 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+// Time of one byte on the line, about 115200 bps
+#define BYTE_TIME 87
+
+static unsigned long fakeNow;
+
+static unsigned long fakeClock() {
+	return fakeNow;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static size_t makeFrame(MockStream &wire, uint8_t *frame, sp_len_t len, uint8_t type) {
+	SimpleCommLink sender(wire);
+	SimplePacket tx;
+	benchFillPacket(tx, len, type);
+	sender.send(tx, 1, type);
+	return wire.readBytes(frame, SP_BUFFER_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Feeds the bytes one at a time, as they arrive on the line. Returns the
+// index of the byte that completed a packet of the given type, -1 if none.
+static int feed(SimpleCommLink &link, SimplePacket &rx, const uint8_t *bytes, size_t len, uint8_t type) {
+	MockStream &stream = (MockStream &) link.getStream();
+	int delivered = -1;
+	for (size_t i = 0; i < len; ++i) {
+		fakeNow += BYTE_TIME;
+		stream.write(bytes[i]);
+		if (link.receive(rx) && rx.getType() == type && delivered < 0) {
+			delivered = i;
+		}
+	}
+	return delivered;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkTimeouts() {
+	MockStream wire;
+	MockStream stream;
+	SimpleCommLink link(stream);
+	SimplePacket rx;
+	link.setClock(fakeClock);
+	link.setResync(false);
+	uint8_t frame[SP_BUFFER_SIZE];
+	size_t frameLen = makeFrame(wire, frame, BENCH_LEN(20), 0x30);
+
+	// Inter-byte timeout: the stale prefix is dropped as soon as the gap is seen
+	link.setTimeouts(1000);
+	feed(link, rx, frame, 10, 0x30);
+	fakeNow += 1001;
+	benchCheck(!link.receive(rx) && link.getStats().timeouts == 1, "inter-byte timeout drops the partial frame");
+	benchCheck(feed(link, rx, frame, frameLen, 0x30) == (int) frameLen - 1, "frame after an inter-byte timeout");
+
+	// A gap shorter than the timeout keeps the frame
+	feed(link, rx, frame, 10, 0x30);
+	fakeNow += 1000 - BYTE_TIME;
+	benchCheck(feed(link, rx, frame + 10, frameLen - 10, 0x30) == (int) frameLen - 11, "gap below the inter-byte timeout");
+
+	// Frame timeout: a frame that trickles in too slowly is dropped
+	link.setTimeouts(1000, 10 * BYTE_TIME);
+	link.resetStats();
+	benchCheck(feed(link, rx, frame, frameLen, 0x30) < 0 && link.getStats().timeouts > 0, "frame timeout");
+	fakeNow += 1001;
+	link.setTimeouts(0, 0);
+	benchCheck(feed(link, rx, frame, frameLen, 0x30) == (int) frameLen - 1, "timeouts disabled");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchGlitches(const char *name, unsigned long interByteTimeout, bool resync) {
+	MockStream wire;
+	MockStream stream;
+	SimpleCommLink link(stream);
+	SimplePacket rx;
+	link.setClock(fakeClock);
+	link.setTimeouts(interByteTimeout);
+	link.setResync(resync);
+
+	const unsigned glitches = 1000;
+	unsigned received = 0;
+	unsigned long lateBytes = 0;
+	for (unsigned i = 0; i < glitches; ++i) {
+		// A frame cut after a few bytes, then a few milliseconds of silence
+		uint8_t frame[SP_BUFFER_SIZE];
+		size_t frameLen = makeFrame(wire, frame, BENCH_LEN(8 + i % 48), 0x10);
+		feed(link, rx, frame, 1 + i % (frameLen - 1), 0x10);
+		fakeNow += 5000;
+		link.receive(rx);
+
+		// Followed by two good frames
+		uint8_t next[2 * SP_BUFFER_SIZE];
+		size_t firstLen = makeFrame(wire, next, 16, 0x20);
+		size_t nextLen = firstLen + makeFrame(wire, next + firstLen, 16, 0x21);
+		int delivered = feed(link, rx, next, nextLen, 0x20);
+		if (delivered >= 0) {
+			++received;
+			lateBytes += delivered - (firstLen - 1);
+		}
+	}
+
+	const SimpleCommStats &stats = link.getStats();
+	benchNote("%-28s %4u/%4u frames after a glitch received, %4.1f bytes late, %4u CRC errors, %4u timeouts",
+			name, received, glitches, received ? (double) lateBytes / received : 0.0,
+			(unsigned) stats.crcErrors, (unsigned) stats.timeouts);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchClockCost(bool timeouts) {
+	MockStream stream;
+	SimpleCommLink link(stream);
+	link.setBulkRead(true);
+	if (timeouts) {
+		link.setTimeouts(1000, 10000);
+	}
+	SimplePacket tx;
+	SimplePacket rx;
+	const sp_len_t len = BENCH_LEN(32);
+	benchFillPacket(tx, len);
+
+	unsigned long iterations = benchIterations(len);
+	unsigned long received = 0;
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		link.send(tx, 1, 0x10);
+		received += link.receive(rx);
+	}
+	double ns = timer.elapsedNs();
+	benchCheck(received == iterations, "every packet received");
+	benchReport(timeouts ? "send+receive, timeouts" : "send+receive, no timeouts", len, iterations, iterations * len, ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchTimeout() {
+	checkTimeouts();
+
+	benchSection("Receive timeouts");
+	benchGlitches("no timeout, no resync", 0, false);
+	benchGlitches("no timeout, resync", 0, true);
+	benchGlitches("1 ms inter-byte timeout", 1000, false);
+	benchClockCost(false);
+	benchClockCost(true);
+}
@@ -0,0 +1,202 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleCommTxQueue.h>
+
+#include <cmath>
+#include <deque>
+
+// 19200 bps, 8N1
+#define BYTE_TIME 521
+#define FIFO_SIZE 64
+
+// UART with a small TX FIFO, on a simulated clock. write() blocks (moves
+// the clock forward) while the FIFO is full, like most Arduino cores do.
+// The bytes that leave the FIFO are delivered to a loopback stream.
+class SimUart : public Stream {
+public:
+	explicit SimUart(MockStream &line) : now(0), _line(line), _headDone(0) {
+	}
+
+	void advance(unsigned long us) {
+		now += us;
+		drain();
+	}
+
+	size_t write(uint8_t c) {
+		return write(&c, 1);
+	}
+
+	size_t write(const uint8_t *buffer, size_t size) {
+		for (size_t i = 0; i < size; ++i) {
+			drain();
+			while (_fifo.size() == FIFO_SIZE) {
+				now = _headDone;
+				drain();
+			}
+			if (_fifo.empty()) {
+				_headDone = now + BYTE_TIME;
+			}
+			_fifo.push_back(buffer[i]);
+		}
+		return size;
+	}
+	using Print::write;
+
+	int availableForWrite() {
+		drain();
+		return FIFO_SIZE - _fifo.size();
+	}
+
+	int available() { return 0; }
+	int read() { return -1; }
+	int peek() { return -1; }
+
+public:
+	unsigned long now;
+
+private:
+	void drain() {
+		while (!_fifo.empty() && now >= _headDone) {
+			_line.write(_fifo.front());
+			_fifo.pop_front();
+			_headDone += BYTE_TIME;
+		}
+	}
+
+private:
+	MockStream &_line;
+	std::deque<uint8_t> _fifo;
+	unsigned long _headDone;
+};
+
+// Stream without availableForWrite(), as the Print default
+class PlainStream : public MockStream {
+public:
+	int availableForWrite() { return 0; }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkTxQueue() {
+	MockStream line(1 << 16);
+	SimUart uart(line);
+	SimpleCommLink link(uart, 5);
+	SimpleCommTxQueueBuffer<3> queue(link);
+	SimpleCommLink receiver(line);
+	SimplePacket tx;
+	SimplePacket rx;
+
+	for (uint8_t i = 0; i < 3; ++i) {
+		benchFillPacket(tx, BENCH_LEN(40 + i), i);
+		benchCheck(queue.send(tx, 7, i), "queue accepts a frame");
+	}
+	benchCheck(queue.isFull() && !queue.send(tx, 7), "queue rejects a frame when full");
+
+	// Nothing is written before the first poll, and a poll never blocks
+	unsigned long start = uart.now;
+	uint8_t received = 0;
+	uint8_t sent = 0;
+	while (!queue.isEmpty()) {
+		sent += queue.poll();
+		benchCheck(uart.now == start, "poll doesn't block");
+		uart.advance(1000);
+		start = uart.now;
+		while (receiver.receive(rx)) {
+			benchCheck(rx.getType() == received && rx.getDataLength() == BENCH_LEN(40 + received)
+					&& rx.getSource() == 5 && rx.getDestination() == 7, "queued frame content and order");
+			++received;
+		}
+	}
+	uart.advance(FIFO_SIZE * BYTE_TIME);
+	while (receiver.receive(rx)) {
+		++received;
+	}
+	benchCheck(sent == 3 && received == 3 && link.getStats().packetsSent == 3, "every queued frame is sent");
+
+	// Streams without availableForWrite() are written up to the write limit
+	PlainStream plain;
+	SimpleCommLink plainLink(plain);
+	SimpleCommTxQueueBuffer<1> plainQueue(plainLink);
+	benchCheck(plainQueue.send(tx, 0, 0x43) && plainQueue.poll() == 1 && plainLink.receive(rx) && rx.getType() == 0x43, "default write limit");
+	plainQueue.setWriteLimit(0);
+	benchCheck(plainQueue.send(tx, 0, 0x44) && plainQueue.poll() == 0 && plain.available() == 0, "no write without a limit");
+	plainQueue.setWriteLimit(16);
+	uint8_t polls = 0;
+	while (!plainQueue.isEmpty()) {
+		benchCheck(plainQueue.poll() <= 1 && plain.available() <= 16 * ++polls, "write limit");
+	}
+	benchCheck(plainLink.receive(rx) && rx.getType() == 0x44, "frame written with a write limit");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchLoop(bool useQueue) {
+	MockStream line(1 << 20);
+	SimUart uart(line);
+	SimpleCommLink link(uart);
+	SimpleCommTxQueueBuffer<4> queue(link);
+	SimplePacket tx;
+	benchFillPacket(tx, BENCH_LEN(40));
+
+	// 1 ms control loop sending a burst of 3 frames every 100 ms, for 10 simulated seconds
+	const unsigned long work = 1000;
+	const unsigned long iterations = 10000;
+	unsigned long maxPeriod = 0;
+	double sum = 0;
+	double sum2 = 0;
+	unsigned long last = uart.now;
+	unsigned long dropped = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		uart.advance(work);
+		if (i % 100 == 0) {
+			for (uint8_t j = 0; j < 3; ++j) {
+				if (useQueue) {
+					dropped += !queue.send(tx, 1, j);
+				}
+				else {
+					link.send(tx, 1, j);
+				}
+			}
+		}
+		if (useQueue) {
+			queue.poll();
+		}
+
+		unsigned long period = uart.now - last;
+		last = uart.now;
+		if (period > maxPeriod) {
+			maxPeriod = period;
+		}
+		sum += period;
+		sum2 += (double) period * period;
+	}
+
+	double mean = sum / iterations;
+	double jitter = sqrt(sum2 / iterations - mean * mean);
+	benchCheck(dropped == 0, "queue never full");
+	benchNote("%-28s loop period %7.1f us avg, %7lu us max, %7.1f us std dev", useQueue ? "queue + poll" : "blocking send", mean, maxPeriod, jitter);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchTxQueue() {
+	checkTxQueue();
+
+	benchSection("Non-blocking send at 19200 bps, 64 byte FIFO");
+	benchLoop(false);
+	benchLoop(true);
+}
@@ -0,0 +1,183 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleDelta.h>
+
+#define FIELDS 16
+#define UPDATES 1000
+#define FRAME_OVERHEAD (SP_SYN_LEN + SP_LEN_LEN + SP_HDR_LEN + SP_CRC_LEN)
+
+// 19200 bps, 8N1
+#define BYTE_TIME_US 521
+
+enum Encoding {
+	FIXED,
+	VARINT,
+	DELTA,
+};
+
+#if SP_MAX_DATA_LEN >= FIELDS * 4
+static uint32_t counters[UPDATES][FIELDS];
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void makeTelemetry() {
+	// Counters of very different magnitudes, all changing slowly
+	uint32_t seed = 1;
+	for (uint8_t j = 0; j < FIELDS; ++j) {
+		counters[0][j] = j < 4 ? j * 10 : j < 12 ? 1000UL << j : 0xFFFF0000UL + j;
+	}
+	for (unsigned i = 1; i < UPDATES; ++i) {
+		for (uint8_t j = 0; j < FIELDS; ++j) {
+			seed = seed * 1103515245 + 12345;
+			counters[i][j] = counters[i - 1][j] + (seed >> 16) % (j < 8 ? 3 : 40);
+		}
+	}
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkVarint() {
+	static const uint32_t values[] = {0, 1, 127, 128, 16383, 16384, 0x0FFFFFFF, 0x10000000, 0xFFFFFFFF};
+	static const uint8_t lengths[] = {1, 1, 1, 2, 2, 3, 4, 5, 5};
+	SimplePacket packet;
+	for (uint8_t i = 0; i < sizeof(lengths); ++i) {
+		uint8_t buffer[SimpleWire::VARINT_MAX_LEN];
+		uint32_t value;
+		benchCheck(SimpleWire::putVarint(buffer, values[i]) == lengths[i]
+				&& SimpleWire::getVarint(buffer, lengths[i], value) == lengths[i] && value == values[i], "varint length");
+		benchCheck(SimpleWire::getVarint(buffer, lengths[i] - 1, value) == 0, "truncated varint");
+
+		// One value at a time, so that a small SP_MAX_DATA_LEN holds them
+		packet.clear();
+		packet.addVarUInt(values[i]);
+		packet.addVarInt((int32_t) values[i]);
+		SimplePacketReader reader(packet);
+		benchCheck(reader.readVarUInt() == values[i] && reader.readVarInt() == (int32_t) values[i], "varint round trip");
+		benchCheck(reader.remaining() == 0 && reader.ok(), "varint payload");
+		reader.readVarUInt();
+		benchCheck(!reader.ok(), "varint past the end");
+	}
+
+	benchCheck(SimpleWire::zigzag(0) == 0 && SimpleWire::zigzag(-1) == 1 && SimpleWire::zigzag(1) == 2
+			&& SimpleWire::zigzag(INT32_MIN) == 0xFFFFFFFF && SimpleWire::unzigzag(0xFFFFFFFE) == INT32_MAX, "zigzag");
+
+	// Deltas wrap around like the counters do
+	SimpleDelta<2> tx;
+	SimpleDelta<2> rx;
+	static const int32_t sequence[][2] = {{5, INT32_MAX}, {3, INT32_MIN}, {-7, 0}, {1000000, -1}};
+	for (uint8_t i = 0; i < 4; ++i) {
+		packet.clear();
+		tx.add(packet, 0, sequence[i][0]);
+		tx.add(packet, 1, sequence[i][1]);
+		SimplePacketReader deltas(packet);
+		int32_t a;
+		int32_t b;
+		benchCheck(rx.read(deltas, 0, a) && rx.read(deltas, 1, b) && a == sequence[i][0] && b == sequence[i][1], "delta round trip");
+	}
+}
+
+#if SP_MAX_DATA_LEN >= FIELDS * 4
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void encode(SimplePacket &packet, SimpleDelta<FIELDS> &delta, const uint32_t *values, Encoding encoding) {
+	packet.clear();
+	for (uint8_t j = 0; j < FIELDS; ++j) {
+		if (encoding == FIXED) {
+			packet.addData(&values[j], sizeof(values[j]));
+		}
+		else if (encoding == VARINT) {
+			packet.addVarUInt(values[j]);
+		}
+		else {
+			delta.add(packet, j, values[j]);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool decode(const SimplePacket &packet, SimpleDelta<FIELDS> &delta, uint32_t *values, Encoding encoding) {
+	SimplePacketReader reader(packet);
+	for (uint8_t j = 0; j < FIELDS; ++j) {
+		if (encoding == FIXED) {
+			values[j] = reader.read<uint32_t>();
+		}
+		else if (encoding == VARINT) {
+			values[j] = reader.readVarUInt();
+		}
+		else {
+			int32_t value = 0;
+			delta.read(reader, j, value);
+			values[j] = value;
+		}
+	}
+	return reader.ok() && reader.remaining() == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchEncoding(Encoding encoding) {
+	static const char *names[] = {"fixed 4 bytes", "varint", "delta + varint"};
+	SimplePacket packet;
+	SimpleDelta<FIELDS> txDelta;
+	SimpleDelta<FIELDS> rxDelta;
+	uint32_t decoded[FIELDS];
+
+	// Size and correctness over the whole series
+	unsigned long bytes = 0;
+	for (unsigned i = 0; i < UPDATES; ++i) {
+		encode(packet, txDelta, counters[i], encoding);
+		bytes += packet.getDataLength();
+		benchCheck(decode(packet, rxDelta, decoded, encoding) && memcmp(decoded, counters[i], sizeof(decoded)) == 0, "telemetry round trip");
+	}
+
+	unsigned long iterations = benchIterations(bytes / UPDATES) / 4;
+	double encodeNs = 0;
+	double decodeNs = 0;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		const uint32_t *values = counters[i % UPDATES];
+		if (i % UPDATES == 0) {
+			txDelta.reset();
+			rxDelta.reset();
+		}
+		BenchTimer timer;
+		encode(packet, txDelta, values, encoding);
+		encodeNs += timer.elapsedNs();
+		timer.start();
+		decode(packet, rxDelta, decoded, encoding);
+		decodeNs += timer.elapsedNs();
+	}
+
+	double frameLen = (double) bytes / UPDATES + FRAME_OVERHEAD;
+	benchNote("%-28s %5.1f payload bytes, %5.1f updates/s at 19200 bps, encode %5.0f ns, decode %5.0f ns",
+			names[encoding], (double) bytes / UPDATES, 1e6 / (frameLen * BYTE_TIME_US), encodeNs / iterations, decodeNs / iterations);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchVarint() {
+	checkVarint();
+
+	benchSection("Telemetry packet of 16 counters");
+#if SP_MAX_DATA_LEN >= FIELDS * 4
+	makeTelemetry();
+	benchEncoding(FIXED);
+	benchEncoding(VARINT);
+	benchEncoding(DELTA);
+#else
+	benchNote("%-28s it needs a larger SP_MAX_DATA_LEN", "");
+#endif
+}
@@ -0,0 +1,190 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bench.h"
+
+#include <SimpleWire.h>
+
+#include <cmath>
+#include <limits>
+
+#define VALUES 256
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static bool encodes(const T &value, const uint8_t *expected) {
+	uint8_t buffer[SimpleWire::Size<T>::value];
+	SimpleWire::put(buffer, value);
+	T decoded;
+	SimpleWire::get(buffer, decoded);
+	return memcmp(buffer, expected, sizeof(buffer)) == 0 && memcmp(&decoded, &value, sizeof(T)) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool sameFloat(float a, float b) {
+	return memcmp(&a, &b, sizeof(a)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void checkWire() {
+	static const uint8_t u16[] = {0x34, 0x12};
+	static const uint8_t i16[] = {0xFE, 0xFF};
+	static const uint8_t u32[] = {0x78, 0x56, 0x34, 0x12};
+	static const uint8_t u64[] = {0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01};
+	static const uint8_t f32[] = {0x00, 0x00, 0xC0, 0x3F};
+	static const uint8_t f64[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F};
+	benchCheck(encodes((uint16_t) 0x1234, u16) && encodes((int16_t) -2, i16) && encodes((uint32_t) 0x12345678, u32)
+			&& encodes((uint64_t) 0x0123456789ABCDEFULL, u64), "little-endian integers");
+	benchCheck(encodes(1.5f, f32) && encodes(1.5, f64), "IEEE float32 and float64");
+	benchCheck(SimpleWire::swap((uint32_t) 0x12345678) == 0x78563412, "byte swap");
+
+#ifdef SP_WIRE_FORMAT
+	// The typed setters use the wire format too
+	SimplePacket packet;
+	packet.setData((SP_INT) -2);
+	packet.addData((SP_ULONG) 0x12345678);
+	const uint8_t *data = (const uint8_t *) packet.getData();
+	benchCheck(packet.getDataLength() == 6 && memcmp(data, i16, 2) == 0 && memcmp(data + 2, u32, 4) == 0, "wire format payload");
+	packet.setData((SP_DOUBLE) 1.5);
+	benchCheck(packet.getDataLength() == SimpleWire::Size<SP_DOUBLE>::value && packet.getDouble() == 1.5, "wire format double");
+#endif
+
+	// Software float32 <-> float64 conversions, used where double is 32 bits
+	static const float specials[] = {0.0f, -0.0f, 1.0f, -1.5f, 1e-45f, 1.17549421e-38f, 1.17549435e-38f, 3.4028235e38f,
+		std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()};
+	for (uint8_t i = 0; i < sizeof(specials) / sizeof(specials[0]); ++i) {
+		double d = specials[i];
+		uint64_t bits;
+		memcpy(&bits, &d, sizeof(bits));
+		benchCheck(SimpleWire::float64Bits(specials[i]) == bits && sameFloat(SimpleWire::fromFloat64Bits(bits), specials[i]),
+				"float32 <-> float64 special values");
+	}
+
+	// Narrowing must round as the FPU does, subnormals included
+	uint64_t seed = 0x9E3779B97F4A7C15ULL;
+	for (unsigned long i = 0; i < 1000000; ++i) {
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		uint64_t bits = seed;
+		if (i & 1) {
+			// Exponents around the float32 range
+			bits = (bits & 0x800FFFFFFFFFFFFFULL) | ((uint64_t) (1023 - 160 + (seed >> 52) % 300) << 52);
+		}
+		double d;
+		memcpy(&d, &bits, sizeof(d));
+		benchCheck(sameFloat(SimpleWire::fromFloat64Bits(bits), (float) d), "float64 -> float32 rounding");
+
+		float f;
+		uint32_t fbits = (uint32_t) seed;
+		memcpy(&f, &fbits, sizeof(f));
+		double wide = f;
+		uint64_t wideBits;
+		memcpy(&wideBits, &wide, sizeof(wideBits));
+		benchCheck(std::isnan(f) || SimpleWire::float64Bits(f) == wideBits, "float32 -> float64");
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void benchEncode(const char *name, bool wire) {
+	T values[VALUES];
+	for (unsigned i = 0; i < VALUES; ++i) {
+		values[i] = (T) (i * 37);
+	}
+	uint8_t buffer[VALUES * SimpleWire::Size<T>::value];
+
+	unsigned long iterations = benchIterations(sizeof(buffer));
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		for (unsigned j = 0; j < VALUES; ++j) {
+			if (wire) {
+				SimpleWire::put(buffer + j * SimpleWire::Size<T>::value, values[j]);
+			}
+			else {
+				memcpy(buffer + j * sizeof(T), &values[j], sizeof(T));
+			}
+		}
+		asm volatile("" : : "r"(buffer) : "memory");
+	}
+	double ns = timer.elapsedNs();
+	benchNote("%-28s %8u %14.2f ns/value", name, (unsigned) sizeof(T), ns / iterations / VALUES);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void benchSwap(const char *name) {
+	T values[VALUES];
+	for (unsigned i = 0; i < VALUES; ++i) {
+		values[i] = (T) (i * 37);
+	}
+
+	unsigned long iterations = benchIterations(sizeof(values));
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		for (unsigned j = 0; j < VALUES; ++j) {
+			values[j] = SimpleWire::swap(values[j]);
+		}
+		asm volatile("" : : "r"(values) : "memory");
+	}
+	double ns = timer.elapsedNs();
+	benchNote("%-28s %8u %14.2f ns/value", name, (unsigned) sizeof(T), ns / iterations / VALUES);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void benchFloat64(bool narrow) {
+	float values[VALUES];
+	uint64_t bits[VALUES];
+	for (unsigned i = 0; i < VALUES; ++i) {
+		values[i] = i * 1.37f - 100;
+		bits[i] = SimpleWire::float64Bits(values[i]);
+	}
+
+	unsigned long iterations = benchIterations(sizeof(bits));
+	BenchTimer timer;
+	for (unsigned long i = 0; i < iterations; ++i) {
+		for (unsigned j = 0; j < VALUES; ++j) {
+			if (narrow) {
+				values[j] = SimpleWire::fromFloat64Bits(bits[j]);
+			}
+			else {
+				bits[j] = SimpleWire::float64Bits(values[j]);
+			}
+		}
+		asm volatile("" : : "r"(values), "r"(bits) : "memory");
+	}
+	double ns = timer.elapsedNs();
+	benchNote("%-28s %8u %14.2f ns/value", narrow ? "float64 -> float32 (soft)" : "float32 -> float64 (soft)", 8, ns / iterations / VALUES);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void benchWire() {
+	checkWire();
+
+	benchSection("Wire format encoding");
+	benchEncode<uint16_t>("memcpy uint16", false);
+	benchEncode<uint16_t>("SimpleWire::put uint16", true);
+	benchEncode<uint32_t>("memcpy uint32", false);
+	benchEncode<uint32_t>("SimpleWire::put uint32", true);
+	benchEncode<double>("memcpy double", false);
+	benchEncode<double>("SimpleWire::put double", true);
+	benchSwap<uint16_t>("byte swap (big-endian CPUs)");
+	benchSwap<uint32_t>("byte swap (big-endian CPUs)");
+	benchSwap<uint64_t>("byte swap (big-endian CPUs)");
+	benchFloat64(false);
+	benchFloat64(true);
+}
@@ -0,0 +1,124 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MockStream.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MockStream::MockStream(size_t capacity) {
+	_buffer = (uint8_t *) malloc(capacity);
+	_capacity = capacity;
+	clear();
+	resetCounters();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MockStream::~MockStream() {
+	free(_buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t MockStream::write(uint8_t c) {
+	return write(&c, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t MockStream::write(const uint8_t *buffer, size_t size) {
+	++writeCalls;
+
+	size_t room = _capacity - _count;
+	if (size > room) {
+		size = room;
+	}
+
+	size_t tail = (_head + _count) % _capacity;
+	size_t first = _capacity - tail;
+	if (first > size) {
+		first = size;
+	}
+	memcpy(_buffer + tail, buffer, first);
+	memcpy(_buffer, buffer + first, size - first);
+
+	_count += size;
+	bytesWritten += size;
+	return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int MockStream::availableForWrite() {
+	return _capacity - _count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int MockStream::available() {
+	++availableCalls;
+	return _count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int MockStream::read() {
+	++readCalls;
+	if (_count == 0) {
+		return -1;
+	}
+
+	uint8_t c = _buffer[_head];
+	_head = (_head + 1) % _capacity;
+	--_count;
+	++bytesRead;
+	return c;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int MockStream::peek() {
+	return _count ? _buffer[_head] : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t MockStream::readBytes(char *buffer, size_t length) {
+	++readBytesCalls;
+	if (length > _count) {
+		length = _count;
+	}
+
+	size_t first = _capacity - _head;
+	if (first > length) {
+		first = length;
+	}
+	memcpy(buffer, _buffer + _head, first);
+	memcpy(buffer + first, _buffer, length - first);
+
+	_head = (_head + length) % _capacity;
+	_count -= length;
+	bytesRead += length;
+	return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MockStream::clear() {
+	_head = 0;
+	_count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void MockStream::resetCounters() {
+	availableCalls = 0;
+	readCalls = 0;
+	readBytesCalls = 0;
+	writeCalls = 0;
+	bytesWritten = 0;
+	bytesRead = 0;
+}
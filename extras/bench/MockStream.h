@@ -0,0 +1,61 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MockStream_H__
+#define __MockStream_H__
+
+#include <Arduino.h>
+
+// Loopback Stream backed by a ring buffer: every written byte becomes
+// available for reading. It counts the virtual calls made on it, so
+// benchmarks can compare how chatty each receive path is.
+class MockStream : public Stream {
+public:
+	explicit MockStream(size_t capacity = 4096);
+	~MockStream();
+
+	size_t write(uint8_t c);
+	size_t write(const uint8_t *buffer, size_t size);
+	using Print::write;
+	int availableForWrite();
+
+	int available();
+	int read();
+	int peek();
+	size_t readBytes(char *buffer, size_t length);
+	using Stream::readBytes;
+
+	// Drop every pending byte
+	void clear();
+	void resetCounters();
+
+public:
+	unsigned long availableCalls;
+	unsigned long readCalls;
+	unsigned long readBytesCalls;
+	unsigned long writeCalls;
+	unsigned long bytesWritten;
+	unsigned long bytesRead;
+
+private:
+	uint8_t *_buffer;
+	size_t _capacity;
+	size_t _head;
+	size_t _count;
+};
+
+#endif // __MockStream_H__
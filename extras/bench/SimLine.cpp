@@ -0,0 +1,84 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimLine.h"
+
+unsigned long simNow;
+
+static uint32_t seed;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long simClock() {
+	return simNow;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void simSeed(uint32_t value) {
+	seed = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint8_t draw() {
+	// 0 to 99
+	seed = seed * 1103515245UL + 12345;
+	return (seed >> 16) % 100;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimLine::SimLine(MockStream &end, uint8_t loss, unsigned long byteTime, unsigned long latency) : _end(end) {
+	_loss = loss;
+	_corrupt = 0;
+	_byteTime = byteTime;
+	_latency = latency;
+	_free = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t SimLine::write(uint8_t c) {
+	return write(&c, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t SimLine::write(const uint8_t *buffer, size_t size) {
+	size_t corrupt = draw() < _loss ? draw() % size : size;
+	if (_corrupt) {
+		--_corrupt;
+		corrupt = size / 2;
+	}
+	unsigned long at = _free > simNow ? _free : simNow;
+	for (size_t i = 0; i < size; ++i) {
+		at += _byteTime;
+		_bytes.push_back(i == corrupt ? buffer[i] ^ 0x5A : buffer[i]);
+		_arrivals.push_back(at + _latency);
+	}
+	_free = at;
+	return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimLine::corruptNext(uint8_t count) {
+	_corrupt = count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimLine::deliver() {
+	while (!_arrivals.empty() && _arrivals.front() <= simNow) {
+		_end.write(_bytes.front());
+		_bytes.pop_front();
+		_arrivals.pop_front();
+	}
+}
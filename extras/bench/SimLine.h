@@ -0,0 +1,86 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SimLine_H__
+#define __SimLine_H__
+
+#include <Arduino.h>
+
+#include <deque>
+
+#include "MockStream.h"
+
+// Simulated time, in microseconds, and a clock for the links reading it
+extern unsigned long simNow;
+unsigned long simClock();
+
+// Restarts the deterministic draws of the lines
+void simSeed(uint32_t seed);
+
+// One direction of a full-duplex serial line on the simulated clock. Each
+// write() is one frame: it leaves after the ones before it, one byte every
+// byteTime, arrives latency later, and one of its bytes is corrupted with a
+// probability of loss%.
+class SimLine : public Stream {
+public:
+	explicit SimLine(MockStream &end, uint8_t loss, unsigned long byteTime, unsigned long latency);
+
+	size_t write(uint8_t c);
+	size_t write(const uint8_t *buffer, size_t size);
+	using Print::write;
+
+	// Moves the bytes arrived by simNow to the other end
+	void deliver();
+
+	// Corrupts the next count frames, whatever the loss
+	void corruptNext(uint8_t count);
+
+	int available() { return 0; }
+	int read() { return -1; }
+	int peek() { return -1; }
+
+private:
+	MockStream &_end;
+	uint8_t _loss;
+	uint8_t _corrupt;
+	unsigned long _byteTime;
+	unsigned long _latency;
+	unsigned long _free;
+	std::deque<uint8_t> _bytes;
+	std::deque<unsigned long> _arrivals;
+};
+
+// Endpoint of a pair of lines: writes go out on one, reads come from the
+// other end of the second one
+class SimPort : public Stream {
+public:
+	explicit SimPort(SimLine &out, MockStream &in) : _out(out), _in(in) {
+	}
+
+	size_t write(uint8_t c) { return _out.write(c); }
+	size_t write(const uint8_t *buffer, size_t size) { return _out.write(buffer, size); }
+	using Print::write;
+
+	int available() { return _in.available(); }
+	int read() { return _in.read(); }
+	int peek() { return _in.peek(); }
+
+private:
+	SimLine &_out;
+	MockStream &_in;
+};
+
+#endif // __SimLine_H__
@@ -0,0 +1,156 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <thread>
+
+HostSerial Serial;
+
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long millis() {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - startTime).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long micros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - startTime).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void delay(unsigned long ms) {
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+String::String(const char *str) {
+	_length = strlen(str);
+	_buffer = (char *) malloc(_length + 1);
+	memcpy(_buffer, str, _length + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+String::String(const String &other) : String(other.c_str()) {
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+String::~String() {
+	free(_buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+String &String::operator=(const String &other) {
+	if (this != &other) {
+		free(_buffer);
+		_length = other._length;
+		_buffer = (char *) malloc(_length + 1);
+		memcpy(_buffer, other._buffer, _length + 1);
+	}
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Print::write(const uint8_t *buffer, size_t size) {
+	size_t n = 0;
+	while (size--) {
+		if (write(*buffer++) == 0) {
+			break;
+		}
+		++n;
+	}
+	return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Print::print(const __FlashStringHelper *str) {
+	return print((const char *) str);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Print::print(const char *str) {
+	return write((const uint8_t *) str, strlen(str));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Print::print(char c) {
+	return write((uint8_t) c);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Print::print(long value, int base) {
+	if (base == DEC) {
+		char buffer[24];
+		snprintf(buffer, sizeof(buffer), "%ld", value);
+		return print(buffer);
+	}
+	return print((unsigned long) value, base);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Print::print(unsigned long value, int base) {
+	char buffer[24];
+	snprintf(buffer, sizeof(buffer), base == HEX ? "%lX" : "%lu", value);
+	return print(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Print::print(double value, int digits) {
+	char buffer[48];
+	snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+	return print(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Print::println() {
+	return print("\r\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int Stream::timedRead() {
+	unsigned long start = millis();
+	do {
+		int c = read();
+		if (c >= 0) {
+			return c;
+		}
+	} while (millis() - start < _timeout);
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t Stream::readBytes(char *buffer, size_t length) {
+	size_t count = 0;
+	while (count < length) {
+		int c = timedRead();
+		if (c < 0) {
+			break;
+		}
+		*buffer++ = (char) c;
+		count++;
+	}
+	return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t HostSerial::write(uint8_t c) {
+	return fputc(c, stderr) == EOF ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Minimal host-side replacement of the Arduino core, just enough to build
+// the SimpleComm sources on Linux for benchmarking. It is NOT a complete
+// Arduino emulation.
+
+#ifndef __Arduino_H__
+#define __Arduino_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *) (addr))
+#define pgm_read_word(addr) (*(const uint16_t *) (addr))
+#define strncpy_P strncpy
+#define memcpy_P memcpy
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+inline bool isAlphaNumeric(int c) {
+	return isalnum(c) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class String {
+public:
+	String(const char *str = "");
+	String(const String &other);
+	~String();
+
+	String &operator=(const String &other);
+
+	const char *c_str() const { return _buffer; }
+	unsigned int length() const { return _length; }
+
+private:
+	char *_buffer;
+	unsigned int _length;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class Print {
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t c) = 0;
+	virtual size_t write(const uint8_t *buffer, size_t size);
+	size_t write(const char *buffer, size_t size) {
+		return write((const uint8_t *) buffer, size);
+	}
+	virtual int availableForWrite() { return 0; }
+	virtual void flush() {}
+
+	size_t print(const __FlashStringHelper *str);
+	size_t print(const char *str);
+	size_t print(char c);
+	size_t print(long value, int base = DEC);
+	size_t print(unsigned long value, int base = DEC);
+	size_t print(int value, int base = DEC) { return print((long) value, base); }
+	size_t print(unsigned int value, int base = DEC) { return print((unsigned long) value, base); }
+	size_t print(unsigned char value, int base = DEC) { return print((unsigned long) value, base); }
+	size_t print(double value, int digits = 2);
+
+	size_t println();
+	template <typename T> size_t println(T value) {
+		return print(value) + println();
+	}
+	template <typename T> size_t println(T value, int format) {
+		return print(value, format) + println();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class Stream : public Print {
+public:
+	Stream() : _timeout(1000) {}
+
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() = 0;
+
+	void setTimeout(unsigned long timeout) { _timeout = timeout; }
+	unsigned long getTimeout() const { return _timeout; }
+
+	// Virtual as in the ESP32 core, so streams backed by a buffer can
+	// override it with a bulk copy; the default reads byte by byte as the
+	// AVR core does
+	virtual size_t readBytes(char *buffer, size_t length);
+	size_t readBytes(uint8_t *buffer, size_t length) {
+		return readBytes((char *) buffer, length);
+	}
+
+protected:
+	int timedRead();
+
+	unsigned long _timeout;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class HostSerial : public Stream {
+public:
+	void begin(unsigned long) {}
+
+	size_t write(uint8_t c);
+	using Print::write;
+	int available() { return 0; }
+	int read() { return -1; }
+	int peek() { return -1; }
+};
+
+extern HostSerial Serial;
+
+#endif // __Arduino_H__
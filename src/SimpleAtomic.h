@@ -0,0 +1,107 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleAtomic_H__
+#define __SimpleAtomic_H__
+
+#include <Arduino.h>
+
+#ifdef __AVR__
+#include <util/atomic.h>
+#endif
+
+
+// Atomic operations on small counters, safe between interrupts and the main
+// loop. AVR has no atomic instructions: interrupts are masked for the few
+// cycles of each operation. Elsewhere they are the GCC __atomic builtins,
+// which don't block.
+class SimpleAtomic {
+public:
+	template <typename T>
+	static T load(const volatile T &value) {
+#ifdef __AVR__
+		T ret;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			ret = value;
+		}
+		return ret;
+#else
+		return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+#endif
+	}
+
+	template <typename T>
+	static void store(volatile T &value, T desired) {
+#ifdef __AVR__
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			value = desired;
+		}
+#else
+		__atomic_store_n(&value, desired, __ATOMIC_RELEASE);
+#endif
+	}
+
+	// Sets value to desired if it is expected. Returns false, leaving it
+	// untouched, when it isn't.
+	template <typename T>
+	static bool compareExchange(volatile T &value, T expected, T desired) {
+#ifdef __AVR__
+		bool swapped = false;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			if (value == expected) {
+				value = desired;
+				swapped = true;
+			}
+		}
+		return swapped;
+#else
+		return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+#endif
+	}
+
+	// Returns the new value
+	template <typename T>
+	static T add(volatile T &value, T delta) {
+#ifdef __AVR__
+		T ret;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			ret = value + delta;
+			value = ret;
+		}
+		return ret;
+#else
+		return __atomic_add_fetch(&value, delta, __ATOMIC_ACQ_REL);
+#endif
+	}
+
+	// Returns the new value
+	template <typename T>
+	static T sub(volatile T &value, T delta) {
+#ifdef __AVR__
+		T ret;
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+			ret = value - delta;
+			value = ret;
+		}
+		return ret;
+#else
+		return __atomic_sub_fetch(&value, delta, __ATOMIC_ACQ_REL);
+#endif
+	}
+};
+
+#endif // __SimpleAtomic_H__
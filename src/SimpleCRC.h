@@ -0,0 +1,47 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleCRC_H__
+#define __SimpleCRC_H__
+
+#include "SimplePacketConfig.h"
+
+#if SP_CRC_MODE == SP_CRC_16_MODBUS
+typedef uint16_t sp_crc_t;
+#define SP_CRC_INIT 0xFFFF
+#else
+typedef uint8_t sp_crc_t;
+#define SP_CRC_INIT 0x00
+#endif
+
+
+class SimpleCRC {
+public:
+	// Integrity check selected by SP_CRC_MODE
+	static sp_crc_t calc(const uint8_t *buffer, size_t len);
+	static sp_crc_t update(sp_crc_t crc, const uint8_t *buffer, size_t len);
+	static sp_crc_t update(sp_crc_t crc, uint8_t value);
+
+	// Every algorithm stays available, so they can be compared
+	static uint8_t sum(uint8_t crc, const uint8_t *buffer, size_t len);
+	static uint8_t crc8(uint8_t crc, const uint8_t *buffer, size_t len);
+	static uint8_t crc8Slice4(uint8_t crc, const uint8_t *buffer, size_t len);
+	static uint16_t crc16Modbus(uint16_t crc, const uint8_t *buffer, size_t len);
+	static uint16_t crc16ModbusSlice4(uint16_t crc, const uint8_t *buffer, size_t len);
+};
+
+#endif // __SimpleCRC_H__
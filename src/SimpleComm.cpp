@@ -18,175 +18,164 @@
 #include "SimpleComm.h"
 
 
-// #define SIMPLECOMM_DEBUG
-
-#ifdef SIMPLECOMM_DEBUG
-static void printBuff(const uint8_t* buff, uint8_t len) {
-	for (uint8_t c = 0; c < len; c++) {
-		uint8_t ch = buff[c];
-		if (isAlphaNumeric(ch)) {
-			Serial.write(ch);
-		}
-		else {
-			Serial.print(F("\\x"));
-			Serial.print(ch, HEX);
-		}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommClass::SimpleCommClass() {
+	for (uint8_t i = 0; i < SIMPLECOMM_RX_STATES; ++i) {
+		_rx[i].packet = NULL;
+		_rx[i].len = 0;
+		_rx[i].skip = 0;
+		_rx[i].crc = SP_CRC_INIT;
+		_rx[i].frameStart = 0;
+		_rx[i].lastByte = 0;
 	}
+	_nextRx = 0;
 }
-#endif
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommClass::begin(uint8_t address) {
+	_link.begin(address);
+}
 
-#define PKT_LEN(dlen) (SP_HDR_LEN + (dlen) + SP_CRC_LEN)
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommClass::setBulkRead(bool enabled) {
+	_link.setBulkRead(enabled);
+}
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommClass::getBulkRead() const {
+	return _link.getBulkRead();
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-SimpleCommClass::SimpleCommClass() {
-	_address = 0;
+void SimpleCommClass::setResync(bool enabled) {
+	_link.setResync(enabled);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimpleCommClass::begin(uint8_t address) {
-	_address = address;
+bool SimpleCommClass::getResync() const {
+	return _link.getResync();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimpleCommClass::send(Stream &stream, SimplePacket &packet, uint8_t destination) {
-	packet._buff.syn = SP_SYN_VALUE;
+void SimpleCommClass::setAddressMask(uint8_t mask) {
+	_link.setAddressMask(mask);
+}
 
-	uint8_t dataLength = packet.getDataLength();
-	if (dataLength > SP_MAX_DATA_LEN) {
-		return false;
-	}
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommClass::getAddressMask() const {
+	return _link.getAddressMask();
+}
 
-	packet._exhausted = true;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommClass::setEarlyFilter(bool enabled) {
+	_link.setEarlyFilter(enabled);
+}
 
-	packet._buff.expectedLen = PKT_LEN(dataLength);
-	packet.setSource(_address);
-	packet.setDestination(destination);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommClass::getEarlyFilter() const {
+	return _link.getEarlyFilter();
+}
 
-#ifdef SIMPLECOMM_DEBUG
-	Serial.print(F("Sending package from 0x")); Serial.print(packet.getSource(), HEX);
-	Serial.print(F(" to 0x")); Serial.println(packet.getDestination(), HEX);
-#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommClass::setTimeouts(unsigned long interByteTimeout, unsigned long frameTimeout) {
+	_link.setTimeouts(interByteTimeout, frameTimeout);
+}
 
-	packet._buff.data[dataLength] = calcCRC(&packet._buff.destination, SP_HDR_LEN + dataLength);
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommClass::setClock(SimpleCommClock clock) {
+	_link.setClock(clock);
+}
 
-	uint8_t totalLength = SP_SYN_LEN + SP_LEN_LEN + PKT_LEN(dataLength);
+#ifdef SP_COMPRESSION
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommClass::setCompression(uint8_t minLength) {
+	_link.setCompression(minLength);
+}
 
-	bool ret = stream.write(&packet._buff.syn, totalLength) == totalLength;
-#ifdef SIMPLECOMM_DEBUG
-	Serial.print(F("Sent package with len "));
-	Serial.print(totalLength);
-        Serial.print(F(": "));
-	printBuff(&packet._buff.syn, totalLength);
-	Serial.println();
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommClass::getCompression() const {
+	return _link.getCompression();
+}
 #endif
-	return ret;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleCommStats &SimpleCommClass::getStats() const {
+	return _link.getStats();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimpleCommClass::send(Stream &stream, SimplePacket &packet, uint8_t destination, uint8_t type) {
+void SimpleCommClass::resetStats() {
+	_link.resetStats();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommClass::send(Stream &stream, SimplePacketBase &packet, uint8_t destination) {
+	// The packet is reused for sending: its partial frame, if any, is lost
+	for (uint8_t i = 0; i < SIMPLECOMM_RX_STATES; ++i) {
+		if (_rx[i].packet == &packet) {
+			_rx[i].len = 0;
+		}
+	}
+
+	return _link.send(stream, packet, destination);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommClass::send(Stream &stream, SimplePacketBase &packet, uint8_t destination, uint8_t type) {
 	packet.setType(type);
 	return send(stream, packet, destination);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimpleCommClass::receive(Stream &stream, SimplePacket &packet) {
-	uint8_t* rxBuffer = &packet._buff.syn;
-	uint8_t* rxBufferLen = &packet._dataLen;
-
-	if (packet._exhausted) {
+bool SimpleCommClass::receive(Stream &stream, SimplePacketBase &packet) {
+	SimpleCommRxState &state = rxState(packet);
+	if (packet._exhausted && state.len == 0 && state.skip == 0) {
+		// A packet returned by the previous call doesn't look new
 #ifdef SIMPLECOMM_DEBUG
 		Serial.println(F("Packet is exhausted, clearing it..."));
 #endif
 		packet.clear();
 	}
 
-	while (stream.available()) {
-		uint8_t in = stream.read();
-
-		if ((*rxBufferLen == 0) && (in != SP_SYN_VALUE)) {
-#ifdef SIMPLECOMM_DEBUG
-			Serial.print(F("Unsynchronized. Byte received was: "));
-			Serial.println(in, HEX);
-#endif
-			continue;
-		}
-
-		if ((*rxBufferLen == SP_SYN_LEN)
-		    && (
-			(in > (SP_HDR_LEN + SP_MAX_DATA_LEN + SP_CRC_LEN))
-			|| (in < (SP_HDR_LEN + SP_CRC_LEN))
-			)) {
-#ifdef SIMPLECOMM_DEBUG
-			Serial.print(F("Invalid data length: "));
-			Serial.println(in);
-#endif
-			packet.clear();
-			continue;
-		}
-
-		rxBuffer[(*rxBufferLen)++] = in;
-
-		if (*rxBufferLen > SP_SYN_LEN + SP_LEN_LEN + SP_HDR_LEN) {
-			uint8_t tlen = rxBuffer[1];
-			if (*rxBufferLen == (tlen + SP_SYN_LEN + SP_LEN_LEN)) {
-				// Buffer complete
-
-				// Check CRC
-				uint8_t expectedCrc = calcCRC(rxBuffer + SP_SYN_LEN + SP_LEN_LEN, tlen - SP_CRC_LEN);
-				if (rxBuffer[SP_SYN_LEN + SP_LEN_LEN + tlen - SP_CRC_LEN] != expectedCrc) {
-#ifdef SIMPLECOMM_DEBUG
-					Serial.print(F("Invalid CRC: "));
-					Serial.print(rxBuffer[SP_SYN_LEN + SP_LEN_LEN + tlen - SP_CRC_LEN], HEX);
-					Serial.print(F(" != "));
-					Serial.print(expectedCrc, HEX);
-					Serial.println();
-					printBuff(rxBuffer, SP_SYN_LEN + SP_LEN_LEN + tlen);
-#endif
-					packet.clear();
-					continue;
-				}
-
-				// Check destination
-				// if my address is 0 then receive all messages
-				// if destination address is 0 then it is a broadcast message
-				if (_address != 0
-				    && rxBuffer[SP_SYN_LEN + SP_LEN_LEN] != 0
-				    && rxBuffer[SP_SYN_LEN + SP_LEN_LEN] != _address) {
-#ifdef SIMPLECOMM_DEBUG
-					Serial.print(F("Received package it's not for me, it was for 0x"));
-					Serial.println(rxBuffer[SP_SYN_LEN + SP_LEN_LEN], HEX);
-#endif
-					packet.clear();
-					continue;
-				}
+	if (!_link.parse(stream, packet, state)) {
+		return false;
+	}
+	packet._exhausted = true;
+	return true;
+}
 
-				packet._dataLen -= SP_SYN_LEN + SP_LEN_LEN + SP_HDR_LEN + SP_CRC_LEN;
-#ifdef SIMPLECOMM_DEBUG
-				Serial.print(F("Good package with len "));
-				Serial.print(packet._dataLen);
-				Serial.print(F(": "));
-				printBuff(packet._buff.data, packet._dataLen);
-				Serial.println();
-#endif
-				packet._exhausted = true;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_crc_t SimpleCommClass::calcCRC(const uint8_t *buffer, size_t len) {
+	return SimpleCRC::calc(buffer, len);
+}
 
-				return true;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommRxState &SimpleCommClass::rxState(SimplePacketBase &packet) {
+	// Only packets holding a partial frame, or skipping one, need a state
+	SimpleCommRxState *idle = NULL;
+	for (uint8_t i = 0; i < SIMPLECOMM_RX_STATES; ++i) {
+		if (_rx[i].len == 0 && _rx[i].skip == 0) {
+			if (!idle) {
+				idle = &_rx[i];
 			}
 		}
+		else if (_rx[i].packet == &packet) {
+			return _rx[i];
+		}
 	}
 
-	return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-uint8_t SimpleCommClass::calcCRC(const uint8_t *buffer, size_t len) {
-	uint8_t ret = 0;
-	while (len--) {
-		ret += *buffer++;
+	if (!idle) {
+		// Too many partial frames: drop the oldest one
+		idle = &_rx[_nextRx];
+		if (++_nextRx == SIMPLECOMM_RX_STATES) {
+			_nextRx = 0;
+		}
+		SP_STAT(_link._stats.bytesDropped += idle->len);
+		idle->len = 0;
+		idle->skip = 0;
 	}
-	return ret;
+
+	return *idle;
 }
 
 SimpleCommClass SimpleComm;
@@ -6,6 +6,15 @@
 
 
 #include "SimplePacket.h"
+#include "SimpleCRC.h"
+#include "SimpleCommLink.h"
+
+/* Number of packets that can hold a partial frame at the same time when
+receiving through SimpleComm (one per stream is usual). SimpleCommLink
+objects don't use it. */
+#ifndef SIMPLECOMM_RX_STATES
+#define SIMPLECOMM_RX_STATES 4
+#endif
 
 
 class SimpleCommClass {
@@ -15,15 +24,56 @@ public:
 public:
 	void begin(uint8_t address = 0);
 
-	bool send(Stream &stream, SimplePacket &packet, uint8_t destination = 0);
-	bool send(Stream &stream, SimplePacket &packet, uint8_t destination, uint8_t type);
-	bool receive(Stream &stream, SimplePacket &packet);
+	bool send(Stream &stream, SimplePacketBase &packet, uint8_t destination = 0);
+	bool send(Stream &stream, SimplePacketBase &packet, uint8_t destination, uint8_t type);
+	// A packet returned by the previous call is cleared first. A frame cut
+	// between calls stays in the packet, and is continued by the next call
+	// with the same packet: until then, the packet must be neither
+	// destroyed nor changed.
+	bool receive(Stream &stream, SimplePacketBase &packet);
+
+	// Bulk read mode: drain the stream with readBytes() instead of one read() per byte
+	void setBulkRead(bool enabled);
+	bool getBulkRead() const;
+
+	// Resynchronisation after a CRC error (enabled by default)
+	void setResync(bool enabled);
+	bool getResync() const;
+
+	// Bits of the destination compared with the address (0xFF by default)
+	void setAddressMask(uint8_t mask);
+	uint8_t getAddressMask() const;
+
+	// Skip frames for other addresses right after their DST byte (disabled by default)
+	void setEarlyFilter(bool enabled);
+	bool getEarlyFilter() const;
+
+	// Receive timeouts, in microseconds (0 disables them, the default)
+	void setTimeouts(unsigned long interByteTimeout, unsigned long frameTimeout = 0);
+	void setClock(SimpleCommClock clock);
+
+#ifdef SP_COMPRESSION
+	// Payloads of at least minLength bytes are sent compressed (0 disables it)
+	void setCompression(uint8_t minLength);
+	uint8_t getCompression() const;
+#endif
+
+	const SimpleCommStats &getStats() const;
+	void resetStats();
+
+	static sp_crc_t calcCRC(const uint8_t *buffer, size_t len);
 
 private:
-	uint8_t calcCRC(const uint8_t *buffer, size_t len);
+	SimpleCommRxState &rxState(SimplePacketBase &packet);
 
 private:
-	uint8_t _address;
+	// Address, options and statistics shared by every stream
+	SimpleCommLink _link;
+
+	// The partial frames are kept in the packets, as in the first versions
+	// of the library, so the state follows the packet
+	SimpleCommRxState _rx[SIMPLECOMM_RX_STATES];
+	uint8_t _nextRx;
 };
 
 extern SimpleCommClass SimpleComm;
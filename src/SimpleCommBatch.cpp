@@ -0,0 +1,88 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommBatch.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommBatch::SimpleCommBatch(SimpleCommLink &link, uint8_t *buffer, size_t size) : _link(link) {
+	_buffer = buffer;
+	_size = size;
+	_length = 0;
+	_count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommBatch::add(SimplePacketBase &packet, uint8_t destination) {
+	if (_count == 0xFF) {
+		return false;
+	}
+
+	if (_link._rx.packet == &packet) {
+		// The packet is reused for sending: its partial frame is lost
+		SP_STAT(_link._stats.bytesDropped += _link._rx.len);
+		_link._rx.len = 0;
+	}
+
+	uint8_t scratch[SP_FRAME_SCRATCH_LEN];
+	const uint8_t *frame;
+	sp_len_t frameLen = _link.encode(packet, destination, scratch, frame);
+	if (frameLen == 0 || _length + frameLen > _size) {
+		return false;
+	}
+
+	memcpy(_buffer + _length, frame, frameLen);
+	_length += frameLen;
+	++_count;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommBatch::add(SimplePacketBase &packet, uint8_t destination, uint8_t type) {
+	packet.setType(type);
+	return add(packet, destination);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommBatch::flush() {
+	if (_length == 0) {
+		return true;
+	}
+
+	bool ret = _link.getStream().write(_buffer, _length) == _length;
+	if (ret) {
+		SP_STAT(_link._stats.packetsSent += _count);
+		SP_STAT(_link._stats.bytesSent += _length);
+	}
+	clear();
+	return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommBatch::count() const {
+	return _count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+size_t SimpleCommBatch::length() const {
+	return _length;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommBatch::clear() {
+	_length = 0;
+	_count = 0;
+}
@@ -0,0 +1,64 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleCommBatch_H__
+#define __SimpleCommBatch_H__
+
+#include "SimpleCommLink.h"
+
+
+// Encodes several packets back to back into one buffer and sends them with
+// a single write, e.g. one TCP segment or one SPI transaction on the
+// Ethernet chip instead of one per packet.
+class SimpleCommBatch {
+public:
+	explicit SimpleCommBatch(SimpleCommLink &link, uint8_t *buffer, size_t size);
+
+	// Encodes the packet at the end of the batch. Returns false when it
+	// doesn't fit (flush() and add it again) or is too long.
+	bool add(SimplePacketBase &packet, uint8_t destination = 0);
+	bool add(SimplePacketBase &packet, uint8_t destination, uint8_t type);
+
+	// Writes the whole batch with one write and empties it. Returns false
+	// when the stream didn't take every byte.
+	bool flush();
+
+	uint8_t count() const;
+	size_t length() const;
+
+	void clear();
+
+private:
+	SimpleCommLink &_link;
+	uint8_t *_buffer;
+	size_t _size;
+	size_t _length;
+	uint8_t _count;
+};
+
+// SimpleCommBatch owning a buffer of SIZE bytes
+template <size_t SIZE>
+class SimpleCommBatchBuffer : public SimpleCommBatch {
+public:
+	explicit SimpleCommBatchBuffer(SimpleCommLink &link) : SimpleCommBatch(link, _bytes, SIZE) {
+	}
+
+private:
+	uint8_t _bytes[SIZE];
+};
+
+#endif // __SimpleCommBatch_H__
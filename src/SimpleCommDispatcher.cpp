@@ -0,0 +1,92 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommDispatcher.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommDispatcher::SimpleCommDispatcher(SimpleCommLink &link, SimpleCommDispatchEntry *table, uint16_t size, uint8_t firstType) : _link(link) {
+	_table = table;
+	_size = size > 0x100 - firstType ? 0x100 - firstType : size;
+	_firstType = firstType;
+	_default = NULL;
+	_unhandled = 0;
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommDispatcher::on(uint8_t type, SimpleCommPacketHandler handler, uint8_t source) {
+	uint8_t index = type - _firstType;
+	if (type < _firstType || index >= _size) {
+		return false;
+	}
+
+	_table[index].handler = handler;
+	_table[index].source = source;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommDispatcher::off(uint8_t type) {
+	on(type, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommDispatcher::clear() {
+	// The table may not be constructed yet (SimpleCommDispatcherBuffer), but it is plain data
+	memset(_table, 0, _size * sizeof(SimpleCommDispatchEntry));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommDispatcher::setDefault(SimpleCommPacketHandler handler) {
+	_default = handler;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommDispatcher::poll() {
+	uint8_t received = 0;
+
+	// Bounded, so a flooded link can't starve the rest of the loop
+	while (received < 0xFF && _link.receive(_packet)) {
+		dispatch(_packet);
+		++received;
+	}
+
+	return received;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommDispatcher::dispatch(SimplePacketBase &packet) {
+	uint8_t index = packet.getType() - _firstType;
+	if (packet.getType() >= _firstType && index < _size) {
+		const SimpleCommDispatchEntry &entry = _table[index];
+		if (entry.handler && (entry.source == 0 || entry.source == packet.getSource())) {
+			entry.handler(packet);
+			return true;
+		}
+	}
+
+	++_unhandled;
+	if (_default) {
+		_default(packet);
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t SimpleCommDispatcher::getUnhandled() const {
+	return _unhandled;
+}
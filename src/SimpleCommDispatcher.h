@@ -0,0 +1,82 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SimpleCommDispatcher_H__
+#define __SimpleCommDispatcher_H__
+
+#include "SimpleCommLink.h"
+
+// Handles a received packet. The packet can be modified, e.g. to send it
+// back as the reply, but it is overwritten by the next one.
+typedef void (*SimpleCommPacketHandler)(SimplePacketBase &packet);
+
+// Handler of one packet type
+typedef struct {
+	SimpleCommPacketHandler handler;
+	// Only packets from this source are handled (0: any source)
+	uint8_t source;
+} SimpleCommDispatchEntry;
+
+// Calls the handler of each received packet from a table indexed by its
+// type, instead of a switch on getType() after every receive(). The table
+// covers the types from firstType on, so a protocol using a few of them
+// doesn't need the 256 entries.
+class SimpleCommDispatcher {
+public:
+	explicit SimpleCommDispatcher(SimpleCommLink &link, SimpleCommDispatchEntry *table, uint16_t size, uint8_t firstType = 0);
+
+	// Returns false when the type is outside of the table
+	bool on(uint8_t type, SimpleCommPacketHandler handler, uint8_t source = 0);
+	void off(uint8_t type);
+	void clear();
+
+	// Handler of the packets without one in the table, or filtered out by
+	// their source (none by default: they are ignored)
+	void setDefault(SimpleCommPacketHandler handler);
+
+	// Receives and dispatches every available packet, up to 255 per call.
+	// Returns the number of packets received.
+	uint8_t poll();
+
+	// Dispatches a packet received elsewhere, e.g. by a SimpleCommReceiver.
+	// Returns false when no handler took it.
+	bool dispatch(SimplePacketBase &packet);
+
+	uint32_t getUnhandled() const;
+
+private:
+	SimpleCommLink &_link;
+	SimpleCommDispatchEntry *_table;
+	uint16_t _size;
+	uint8_t _firstType;
+	SimpleCommPacketHandler _default;
+	uint32_t _unhandled;
+	// Kept between calls: it may hold a partial frame
+	SimplePacket _packet;
+};
+
+// SimpleCommDispatcher owning a table of N types from FIRST on
+template <uint16_t N = 256, uint8_t FIRST = 0>
+class SimpleCommDispatcherBuffer : public SimpleCommDispatcher {
+public:
+	explicit SimpleCommDispatcherBuffer(SimpleCommLink &link) : SimpleCommDispatcher(link, _entries, N, FIRST) {
+	}
+
+private:
+	SimpleCommDispatchEntry _entries[N];
+};
+
+#endif // __SimpleCommDispatcher_H__
@@ -0,0 +1,419 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommFragment.h"
+#include "SimpleWire.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommFragmenter::SimpleCommFragmenter(SimpleCommLink &link, uint8_t type) : _link(link) {
+	_type = type;
+	_data = NULL;
+	_length = 0;
+	_destination = 0;
+	_id = 0;
+	_chunk = SP_MAX_DATA_LEN - SimpleCommFragment::HEADER_LEN;
+	_count = 0;
+	_base = 0;
+	_top = 0;
+	_sent = 0;
+	_acked = 0;
+	_resent = 0;
+	_window = 8;
+	_retries = 5;
+	_tries = 0;
+	_timeout = 1000000UL;
+	_timer = 0;
+	_busy = false;
+	_failed = false;
+	_retransmissions = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommFragmenter::send(const void *data, uint32_t length, uint8_t destination) {
+	if (_busy) {
+		return false;
+	}
+
+	// An empty message is still one (empty) fragment
+	uint32_t count = length ? (length + _chunk - 1) / _chunk : 1;
+	if (count > SimpleCommFragment::MAX_FRAGMENTS) {
+		return false;
+	}
+
+	_data = (const uint8_t*) data;
+	_length = length;
+	_destination = destination;
+	++_id;
+	_count = count;
+	_base = 0;
+	_top = 0;
+	_sent = 0;
+	_acked = 0;
+	_resent = 0;
+	_tries = 0;
+	_busy = true;
+	_failed = false;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommFragmenter::poll() {
+	if (!_busy) {
+		return 0;
+	}
+
+	unsigned long now = _link._clock();
+	uint32_t outstanding = _sent & ~_acked;
+	if (outstanding && now - _timer >= _timeout) {
+		if (_tries++ == _retries) {
+			_busy = false;
+			_failed = true;
+			return 0;
+		}
+		// Go back over every fragment of the window not acknowledged yet
+		_sent = _acked;
+		_resent = 0;
+		outstanding = 0;
+	}
+	if (!outstanding) {
+		_timer = now;
+	}
+
+	uint8_t window = _window;
+	if (window > _count - _base) {
+		window = _count - _base;
+	}
+	uint32_t pending = ~(_sent | _acked);
+	if (window < SimpleCommFragment::MAX_WINDOW) {
+		pending &= (1UL << window) - 1;
+	}
+
+	// ACKs are requested halfway through the window and by the last
+	// fragment written, so the window never waits for the timeout
+	uint8_t ackEvery = (_window + 1) / 2;
+	uint8_t written = 0;
+	for (uint8_t i = 0; pending; ++i) {
+		uint32_t bit = 1UL << i;
+		if (!(pending & bit)) {
+			continue;
+		}
+		pending &= ~bit;
+
+		uint16_t sequence = _base + i;
+		bool ackRequest = !pending || (sequence + 1) % ackEvery == 0;
+		if (!sendFragment(sequence, ackRequest)) {
+			break;
+		}
+		_sent |= bit;
+		++written;
+		if (sequence < _top) {
+			++_retransmissions;
+		}
+		else {
+			_top = sequence + 1;
+		}
+	}
+
+	return written;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommFragmenter::handle(const SimplePacketBase &packet) {
+	if (packet.getType() != (uint8_t) (_type + 1)) {
+		return false;
+	}
+
+	sp_len_t len;
+	const uint8_t *data = (const uint8_t*) packet.getData(len);
+	if (!_busy || len != SimpleCommFragment::ACK_LEN || data[0] != _id
+	    || (_destination != 0 && packet.getSource() != _destination)) {
+		// Late or duplicated ACK of an earlier transfer
+		return true;
+	}
+
+	uint16_t next;
+	uint32_t received;
+	SimpleWire::get(data + 1, next);
+	SimpleWire::get(data + 3, received);
+	if (next < _base || next > _count) {
+		return true;
+	}
+
+	uint16_t shift = next - _base;
+	if (shift) {
+		_sent = shift < 32 ? _sent >> shift : 0;
+		_acked = shift < 32 ? _acked >> shift : 0;
+		_resent = shift < 32 ? _resent >> shift : 0;
+		_base = next;
+		_tries = 0;
+		_timer = _link._clock();
+	}
+	if (_base == _count) {
+		_busy = false;
+		return true;
+	}
+
+	// The next expected fragment is bit 0, the ones received after it follow
+	_acked |= received << 1;
+
+	// Fragments missing below the highest acknowledged one were lost: send
+	uint32_t below = _acked;
+	below |= below >> 1;
+	below |= below >> 2;
+	below |= below >> 4;
+	below |= below >> 8;
+	below |= below >> 16;
+	// them again without waiting for the timeout, once: later ACKs may be
+	// sent before the resent ones arrive
+	uint32_t lost = (below >> 1) & ~_acked & ~_resent;
+	_sent &= ~lost;
+	_resent |= lost;
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommFragmenter::setWindow(uint8_t window) {
+	if (window < 1) {
+		window = 1;
+	}
+	if (window > SimpleCommFragment::MAX_WINDOW) {
+		window = SimpleCommFragment::MAX_WINDOW;
+	}
+	_window = window;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommFragmenter::getWindow() const {
+	return _window;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommFragmenter::setTimeout(unsigned long timeout) {
+	_timeout = timeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommFragmenter::setRetries(uint8_t retries) {
+	_retries = retries;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommFragmenter::isBusy() const {
+	return _busy;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommFragmenter::hasFailed() const {
+	return _failed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommFragmenter::cancel() {
+	_busy = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t SimpleCommFragmenter::getRetransmissions() const {
+	return _retransmissions;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommFragmenter::sendFragment(uint16_t sequence, bool ackRequest) {
+	uint32_t offset = (uint32_t) sequence * _chunk;
+	sp_len_t len = _chunk;
+	uint16_t field = sequence;
+	if (sequence == _count - 1) {
+		len = _length - offset;
+		field |= SimpleCommFragment::LAST;
+	}
+	if (ackRequest) {
+		field |= SimpleCommFragment::ACK_REQUEST;
+	}
+
+	uint8_t header[SimpleCommFragment::HEADER_LEN];
+	header[0] = _id;
+	SimpleWire::put(header + 1, field);
+	SimpleWire::put(header + 3, (uint16_t) _chunk);
+
+	_packet.setData(header, sizeof(header));
+	_packet.addData(_data + offset, len);
+	return _link.send(_packet, _destination, _type);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommReassembler::SimpleCommReassembler(SimpleCommLink &link, uint8_t *buffer, uint32_t size, uint8_t type) : _link(link) {
+	_type = type;
+	_buffer = buffer;
+	_size = size;
+	_length = 0;
+	_source = 0;
+	_id = 0;
+	_next = 0;
+	_count = 0;
+	_received = 0;
+	_timeout = 10000000UL;
+	_lastFragment = 0;
+	_active = false;
+	_complete = false;
+	_gapAcked = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReassembler::handle(const SimplePacketBase &packet) {
+	if (packet.getType() != _type) {
+		return false;
+	}
+
+	sp_len_t len;
+	const uint8_t *data = (const uint8_t*) packet.getData(len);
+	if (len < SimpleCommFragment::HEADER_LEN) {
+		return true;
+	}
+
+	uint8_t id = data[0];
+	uint16_t field;
+	uint16_t chunk;
+	SimpleWire::get(data + 1, field);
+	SimpleWire::get(data + 3, chunk);
+	uint16_t sequence = field & SimpleCommFragment::SEQUENCE_MASK;
+	bool last = field & SimpleCommFragment::LAST;
+	sp_len_t dataLen = len - SimpleCommFragment::HEADER_LEN;
+	data += SimpleCommFragment::HEADER_LEN;
+	unsigned long now = _link._clock();
+
+	if (_active && (packet.getSource() != _source || id != _id)) {
+		if (_complete || (packet.getSource() != _source && (!_timeout || now - _lastFragment < _timeout))) {
+			// Busy with another message
+			return true;
+		}
+		// The sender gave up the previous message and started a new one, or
+		// stopped sending it
+		_active = false;
+	}
+	_lastFragment = now;
+	if (!_active) {
+		if (_count && _next == _count && packet.getSource() == _source && id == _id) {
+			// Resent because the last ACK of a released message was lost
+			ack();
+			return true;
+		}
+		_active = true;
+		_source = packet.getSource();
+		_id = id;
+		_next = 0;
+		_count = 0;
+		_received = 0;
+		_length = 0;
+		_gapAcked = false;
+	}
+
+	if (sequence < _next || (sequence - _next < 32 && (_received & (1UL << (sequence - _next))))) {
+		// Resent because its ACK was lost
+		ack();
+		return true;
+	}
+
+	uint32_t offset = (uint32_t) sequence * chunk;
+	if (sequence - _next >= 32
+	    || (_count && sequence >= _count)
+	    || (last ? dataLen > chunk : dataLen != chunk)
+	    || offset + dataLen > _size) {
+		return true;
+	}
+
+	memcpy(_buffer + offset, data, dataLen);
+	_received |= 1UL << (sequence - _next);
+	if (last) {
+		_count = sequence + 1;
+		_length = offset + dataLen;
+	}
+
+	bool advanced = false;
+	while (_received & 1) {
+		_received >>= 1;
+		++_next;
+		advanced = true;
+	}
+	if (advanced) {
+		_gapAcked = false;
+	}
+
+	if (_count && _next == _count) {
+		_complete = true;
+		ack();
+	}
+	else if (_received && !_gapAcked) {
+		// The first fragment after a loss tells the sender right away
+		_gapAcked = true;
+		ack();
+	}
+	else if (field & SimpleCommFragment::ACK_REQUEST) {
+		ack();
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReassembler::isComplete() const {
+	return _complete;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint8_t *SimpleCommReassembler::getData() const {
+	return _buffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t SimpleCommReassembler::getLength() const {
+	return _complete ? _length : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommReassembler::getSource() const {
+	return _source;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReassembler::release() {
+	// The state is kept, so the fragments resent after a lost final ACK are
+	// still recognised until another message starts
+	_active = false;
+	_complete = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReassembler::setTimeout(unsigned long timeout) {
+	_timeout = timeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SimpleCommReassembler::getTimeout() const {
+	return _timeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReassembler::ack() {
+	uint8_t ack[SimpleCommFragment::ACK_LEN];
+	ack[0] = _id;
+	SimpleWire::put(ack + 1, _next);
+	SimpleWire::put(ack + 3, _received >> 1);
+
+	_packet.setData(ack, sizeof(ack));
+	_link.send(_packet, _source, _type + 1);
+}
@@ -0,0 +1,160 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SimpleCommFragment_H__
+#define __SimpleCommFragment_H__
+
+#include "SimpleCommLink.h"
+
+// Packet type of the fragments. Their ACKs use the next type.
+#ifndef SP_FRAGMENT_TYPE
+#define SP_FRAGMENT_TYPE 0xF0
+#endif
+
+
+// Messages longer than a packet, sent as numbered fragments with up to a
+// window of them in flight. Fragment payload: message id, sequence number
+// (16 bits, little-endian, with the LAST and ACK_REQUEST flags on top) and
+// the fragment length, then the data. ACK payload: message id, next
+// expected sequence number (16 bits) and a bitmap of the 32 fragments
+// after it already received (32 bits), so only the lost ones are resent.
+class SimpleCommFragment {
+public:
+	static const uint8_t HEADER_LEN = 5;
+	static const uint8_t ACK_LEN = 7;
+	static const uint8_t MAX_WINDOW = 32;
+	static const uint16_t MAX_FRAGMENTS = 0x4000;
+
+	static const uint16_t LAST = 0x8000;
+	static const uint16_t ACK_REQUEST = 0x4000;
+	static const uint16_t SEQUENCE_MASK = 0x3FFF;
+};
+
+// Sending side. The caller feeds it the received packets through handle()
+// and calls poll() from its loop.
+class SimpleCommFragmenter {
+public:
+	explicit SimpleCommFragmenter(SimpleCommLink &link, uint8_t type = SP_FRAGMENT_TYPE);
+
+	// Starts sending a message. The data is not copied: it must stay
+	// untouched until the transfer ends. Returns false while busy or when
+	// the message needs more than MAX_FRAGMENTS fragments.
+	bool send(const void *data, uint32_t length, uint8_t destination);
+
+	// Writes the fragments the window allows and resends the unacknowledged
+	// ones on timeout. Returns the number of fragments written.
+	uint8_t poll();
+
+	// Consumes the ACKs of this fragmenter: returns false for any other packet
+	bool handle(const SimplePacketBase &packet);
+
+	// Fragments sent before waiting for an ACK: 1 (stop-and-wait) to
+	// MAX_WINDOW, 8 by default
+	void setWindow(uint8_t window);
+	uint8_t getWindow() const;
+
+	// Time without progress before resending, in microseconds of the link
+	// clock (1 s by default). It must cover a window of fragments on the
+	// line plus the ACK.
+	void setTimeout(unsigned long timeout);
+
+	// Timeouts in a row before giving up (5 by default)
+	void setRetries(uint8_t retries);
+
+	bool isBusy() const;
+	// The last transfer was given up
+	bool hasFailed() const;
+	void cancel();
+
+	// Fragments sent more than once since the creation
+	uint32_t getRetransmissions() const;
+
+private:
+	bool sendFragment(uint16_t sequence, bool ackRequest);
+
+private:
+	SimpleCommLink &_link;
+	uint8_t _type;
+	SimplePacket _packet;
+	const uint8_t *_data;
+	uint32_t _length;
+	uint8_t _destination;
+	uint8_t _id;
+	sp_len_t _chunk;
+	uint16_t _count;
+	uint16_t _base;
+	uint16_t _top;
+	uint32_t _sent;
+	uint32_t _acked;
+	uint32_t _resent;
+	uint8_t _window;
+	uint8_t _retries;
+	uint8_t _tries;
+	unsigned long _timeout;
+	unsigned long _timer;
+	bool _busy;
+	bool _failed;
+	uint32_t _retransmissions;
+};
+
+// Receiving side: reassembles one message at a time into the caller's
+// buffer and acknowledges its fragments
+class SimpleCommReassembler {
+public:
+	explicit SimpleCommReassembler(SimpleCommLink &link, uint8_t *buffer, uint32_t size, uint8_t type = SP_FRAGMENT_TYPE);
+
+	// Consumes the fragments: returns false for any other packet. Fragments
+	// that don't fit in the buffer are dropped, so their sender gives up.
+	bool handle(const SimplePacketBase &packet);
+
+	// A complete message stays in the buffer, and the fragments of the next
+	// ones are ignored, until release() is called
+	bool isComplete() const;
+	const uint8_t *getData() const;
+	uint32_t getLength() const;
+	uint8_t getSource() const;
+	void release();
+
+	// Time without fragments after which an incomplete message is dropped
+	// when another source starts one, in microseconds of the link clock
+	// (10 s by default, 0 never drops it). It must be longer than the time
+	// its sender takes to give up, or a slow transfer is lost.
+	void setTimeout(unsigned long timeout);
+	unsigned long getTimeout() const;
+
+private:
+	void ack();
+
+private:
+	SimpleCommLink &_link;
+	uint8_t _type;
+	SimplePacket _packet;
+	uint8_t *_buffer;
+	uint32_t _size;
+	uint32_t _length;
+	uint8_t _source;
+	uint8_t _id;
+	uint16_t _next;
+	uint16_t _count;
+	uint32_t _received;
+	unsigned long _timeout;
+	unsigned long _lastFragment;
+	bool _active;
+	bool _complete;
+	bool _gapAcked;
+};
+
+#endif // __SimpleCommFragment_H__
@@ -0,0 +1,998 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommLink.h"
+#include "SimpleLZ.h"
+#include "SimpleAtomic.h"
+
+
+// #define SIMPLECOMM_DEBUG
+
+#ifdef SIMPLECOMM_DEBUG
+static void printBuff(const uint8_t* buff, sp_len_t len) {
+	for (sp_len_t c = 0; c < len; c++) {
+		uint8_t ch = buff[c];
+		if (isAlphaNumeric(ch)) {
+			Serial.write(ch);
+		}
+		else {
+			Serial.print(F("\\x"));
+			Serial.print(ch, HEX);
+		}
+	}
+}
+#endif
+
+
+// Bytes of a skipped frame read at a time
+#define SKIP_CHUNK_LEN 32
+
+// Counters of SimpleCommStats before the histogram
+#define STATS_COUNTERS 10
+// Counters of SimpleCommPoolStats
+#define POOL_COUNTERS 4
+static_assert(offsetof(SimpleCommStats, formatErrors) == 4 * (STATS_COUNTERS - 1), "STATS_COUNTERS out of date");
+
+#define PKT_LEN(dlen) (SP_HDR_LEN + (dlen) + SP_CRC_LEN)
+
+static inline void putCRC(uint8_t *buffer, sp_crc_t crc) {
+	buffer[0] = crc & 0xFF;
+#if SP_CRC_LEN == 2
+	buffer[1] = crc >> 8;
+#endif
+}
+
+static inline sp_crc_t getCRC(const uint8_t *buffer) {
+#if SP_CRC_LEN == 2
+	return buffer[0] | (buffer[1] << 8);
+#else
+	return buffer[0];
+#endif
+}
+
+// SYN byte, with any of the flags this build understands
+static inline bool isSyn(uint8_t value) {
+	return (value & ~SP_SYN_FLAGS) == SP_SYN_VALUE;
+}
+
+// Bytes of SYN and LEN of a frame starting with the given SYN
+static inline uint8_t headLen(uint8_t syn) {
+#ifdef SP_LONG_FRAMES
+	if (syn & SP_SYN_LONG) {
+		return SP_SYN_LEN + SP_LEN_EXT_LEN + SP_LEN_LEN;
+	}
+#else
+	(void) syn;
+#endif
+	return SP_SYN_LEN + SP_LEN_LEN;
+}
+
+// LEN of a frame, once its SYN and LEN bytes are in place
+static inline sp_len_t getLen(const uint8_t *frame) {
+#ifdef SP_LONG_FRAMES
+	if (frame[0] & SP_SYN_LONG) {
+		return ((sp_len_t) frame[SP_SYN_LEN] << 8) | frame[SP_SYN_LEN + SP_LEN_EXT_LEN];
+	}
+#endif
+	return frame[SP_SYN_LEN];
+}
+
+// LEN of a frame that fits in a packet with the given capacity
+static inline bool validLen(sp_len_t tlen, sp_len_t capacity) {
+	return (tlen >= SP_HDR_LEN + SP_CRC_LEN) && (tlen <= SP_HDR_LEN + capacity + SP_CRC_LEN);
+}
+
+// Start of the frame held by a packet buffer. Long frames start at the
+// lead byte and the others right after it (the lead byte is then 0), so the
+// header and the data are in place in both.
+static inline uint8_t *frameIn(uint8_t *buffer) {
+#ifdef SP_LONG_FRAMES
+	return buffer[0] ? buffer : buffer + 1;
+#else
+	return buffer;
+#endif
+}
+
+// Moves the len bytes of a frame found at from to where its SYN puts it in
+// a packet buffer
+static uint8_t *placeFrame(uint8_t *buffer, const uint8_t *from, sp_len_t len) {
+	uint8_t *frame = buffer;
+#ifdef SP_LONG_FRAMES
+	bool isLong = (len > 0) && (from[0] & SP_SYN_LONG);
+	if (!isLong) {
+		frame = buffer + 1;
+	}
+#endif
+	if (frame != from) {
+		memmove(frame, from, len);
+	}
+#ifdef SP_LONG_FRAMES
+	if (!isLong) {
+		buffer[0] = 0;
+	}
+#endif
+	return frame;
+}
+
+// Writes SYN and LEN before the header of a packet buffer, in a long frame
+// only when LEN doesn't fit in one byte, and returns the frame length
+static sp_len_t putHead(uint8_t *buffer, uint8_t flags, sp_len_t tlen, const uint8_t *&frame) {
+	uint8_t *start = buffer;
+#ifdef SP_LONG_FRAMES
+	if (tlen > 0xFF) {
+		buffer[0] = SP_SYN_VALUE | SP_SYN_LONG | flags;
+		buffer[SP_SYN_LEN] = tlen >> 8;
+		buffer[SP_SYN_LEN + SP_LEN_EXT_LEN] = tlen & 0xFF;
+		frame = buffer;
+		return SP_SYN_LEN + SP_LEN_EXT_LEN + SP_LEN_LEN + tlen;
+	}
+	buffer[0] = 0;
+	start = buffer + 1;
+#endif
+	start[0] = SP_SYN_VALUE | flags;
+	start[SP_SYN_LEN] = tlen;
+	frame = start;
+	return SP_SYN_LEN + SP_LEN_LEN + tlen;
+}
+
+// First byte of a new frame
+static void startFrame(SimplePacketBase &packet, SimpleCommRxState &state, uint8_t *buffer, uint8_t syn) {
+	// The previous content of the packet is being overwritten
+	packet.clear();
+	state.crc = SP_CRC_INIT;
+	state.frameStart = state.lastByte;
+#ifdef SP_LONG_FRAMES
+	buffer[0] = (syn & SP_SYN_LONG) ? syn : 0;
+#endif
+	frameIn(buffer)[0] = syn;
+	state.len = SP_SYN_LEN;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommLink::SimpleCommLink(Stream &stream, uint8_t address) {
+	_stream = &stream;
+	_address = address;
+	_addressMask = 0xFF;
+	_earlyFilter = false;
+	_bulkRead = false;
+	_resync = true;
+	_interByteTimeout = 0;
+	_frameTimeout = 0;
+	_clock = micros;
+#ifdef SP_COMPRESSION
+	_compressMin = 0;
+#endif
+	_pool = NULL;
+	_rx.packet = NULL;
+	_rx.len = 0;
+	_rx.skip = 0;
+	_rx.crc = SP_CRC_INIT;
+	_rx.frameStart = 0;
+	_rx.lastByte = 0;
+	resetStats();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommLink::SimpleCommLink() {
+	_stream = NULL;
+	_address = 0;
+	_addressMask = 0xFF;
+	_earlyFilter = false;
+	_bulkRead = false;
+	_resync = true;
+	_interByteTimeout = 0;
+	_frameTimeout = 0;
+	_clock = micros;
+#ifdef SP_COMPRESSION
+	_compressMin = 0;
+#endif
+	_pool = NULL;
+	_rx.packet = NULL;
+	_rx.len = 0;
+	_rx.skip = 0;
+	_rx.crc = SP_CRC_INIT;
+	_rx.frameStart = 0;
+	_rx.lastByte = 0;
+	resetStats();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::begin(uint8_t address) {
+	_address = address;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommLink::getAddress() const {
+	return _address;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Stream &SimpleCommLink::getStream() const {
+	return *_stream;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::setAddressMask(uint8_t mask) {
+	_addressMask = mask;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommLink::getAddressMask() const {
+	return _addressMask;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::setEarlyFilter(bool enabled) {
+	_earlyFilter = enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::getEarlyFilter() const {
+	return _earlyFilter;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::setBulkRead(bool enabled) {
+	_bulkRead = enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::getBulkRead() const {
+	return _bulkRead;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::setResync(bool enabled) {
+	_resync = enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::getResync() const {
+	return _resync;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::setTimeouts(unsigned long interByteTimeout, unsigned long frameTimeout) {
+	_interByteTimeout = interByteTimeout;
+	_frameTimeout = frameTimeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SimpleCommLink::getInterByteTimeout() const {
+	return _interByteTimeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SimpleCommLink::getFrameTimeout() const {
+	return _frameTimeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::setClock(SimpleCommClock clock) {
+	_clock = clock ? clock : micros;
+}
+
+#ifdef SP_COMPRESSION
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::setCompression(uint8_t minLength) {
+	_compressMin = minLength;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommLink::getCompression() const {
+	return _compressMin;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleCommStats &SimpleCommLink::getStats() const {
+#if SP_STATS
+	return _stats;
+#else
+	static const SimpleCommStats none = SimpleCommStats();
+	return none;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::resetStats() {
+#if SP_STATS
+	memset(&_stats, 0, sizeof(_stats));
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::setPool(const SimpleCommPacketPool *pool) {
+	_pool = pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::exportStats(SimplePacketBase &packet) const {
+#if SP_STATS
+	static const uint8_t counters = STATS_COUNTERS;
+	uint8_t buffer[3 + sizeof(SimpleCommStats) + 4 * POOL_COUNTERS];
+	uint8_t *out = buffer;
+	const uint32_t *values = (const uint32_t*) &_stats;
+
+	*out++ = counters;
+	for (uint8_t i = 0; i < counters; ++i, out += 4) {
+		SimpleWire::put(out, values[i]);
+	}
+#ifdef SP_STATS_LATENCY
+	*out++ = SP_STATS_LATENCY_BUCKETS;
+	for (uint8_t i = 0; i < SP_STATS_LATENCY_BUCKETS; ++i, out += 4) {
+		SimpleWire::put(out, _stats.receiveTime[i]);
+	}
+#else
+	*out++ = 0;
+#endif
+
+	if (_pool) {
+		// Counted from interrupts too: read as a whole
+		const SimpleCommPoolStats &stats = _pool->getStats();
+		const uint32_t pool[POOL_COUNTERS] = {
+			stats.size,
+			SimpleAtomic::load(stats.used),
+			SimpleAtomic::load(stats.peak),
+			SimpleAtomic::load(stats.failures),
+		};
+		*out++ = POOL_COUNTERS;
+		for (uint8_t i = 0; i < POOL_COUNTERS; ++i, out += 4) {
+			SimpleWire::put(out, pool[i]);
+		}
+	}
+	else {
+		*out++ = 0;
+	}
+
+	packet.setType(SP_STATS_TYPE);
+	return packet.setData(buffer, out - buffer);
+#else
+	(void) packet;
+	return false;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::importStats(const SimplePacketBase &packet, SimpleCommStats &stats, SimpleCommPoolStats *pool) {
+	sp_len_t len;
+	const uint8_t *in = (const uint8_t*) packet.getData(len);
+	if (packet.getType() != SP_STATS_TYPE || len == 0 || len < 1 + 4 * in[0] + 1) {
+		return false;
+	}
+
+	memset(&stats, 0, sizeof(stats));
+	uint32_t *values = (uint32_t*) &stats;
+	uint8_t counters = *in++;
+	for (uint8_t i = 0; i < counters; ++i, in += 4) {
+		// Counters added by newer versions are skipped
+		if (i < STATS_COUNTERS) {
+			SimpleWire::get(in, values[i]);
+		}
+	}
+
+	uint8_t buckets = *in++;
+	if (len < 1 + 4 * counters + 1 + 4 * buckets) {
+		return false;
+	}
+#ifdef SP_STATS_LATENCY
+	for (uint8_t i = 0; i < buckets && i < SP_STATS_LATENCY_BUCKETS; ++i) {
+		SimpleWire::get(in + 4 * i, stats.receiveTime[i]);
+	}
+#endif
+	in += 4 * buckets;
+
+	if (pool) {
+		memset(pool, 0, sizeof(*pool));
+		// Older versions don't export the pool
+		uint16_t offset = 1 + 4 * counters + 1 + 4 * buckets;
+		if (len > offset) {
+			uint8_t poolCounters = *in++;
+			if (len < offset + 1 + 4 * poolCounters) {
+				return false;
+			}
+			uint32_t values[POOL_COUNTERS] = {0};
+			for (uint8_t i = 0; i < poolCounters && i < POOL_COUNTERS; ++i) {
+				SimpleWire::get(in + 4 * i, values[i]);
+			}
+			pool->size = values[0];
+			pool->used = values[1];
+			pool->peak = values[2];
+			pool->failures = values[3];
+		}
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::send(SimplePacketBase &packet, uint8_t destination) {
+	if (_rx.packet == &packet) {
+		// The packet is reused for sending: its partial frame is lost
+		SP_STAT(_stats.bytesDropped += _rx.len);
+		_rx.len = 0;
+	}
+
+	return send(*_stream, packet, destination);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::send(SimplePacketBase &packet, uint8_t destination, uint8_t type) {
+	packet.setType(type);
+	return send(packet, destination);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::send(Stream &stream, SimplePacketBase &packet, uint8_t destination) {
+	uint8_t scratch[SP_FRAME_SCRATCH_LEN];
+	const uint8_t *frame;
+	sp_len_t totalLength = encode(packet, destination, scratch, frame);
+	if (totalLength == 0) {
+		return false;
+	}
+
+	bool ret = stream.write(frame, totalLength) == totalLength;
+#ifdef SIMPLECOMM_DEBUG
+	Serial.print(F("Sent package with len "));
+	Serial.print(totalLength);
+	Serial.print(F(": "));
+	printBuff(frame, totalLength);
+	Serial.println();
+#endif
+	if (ret) {
+		SP_STAT(++_stats.packetsSent);
+		SP_STAT(_stats.bytesSent += totalLength);
+	}
+	return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_len_t SimpleCommLink::encode(SimplePacketBase &packet, uint8_t destination, uint8_t *scratch, const uint8_t *&frame) {
+	sp_len_t dataLength = packet.getDataLength();
+	if (dataLength > SP_MAX_DATA_LEN) {
+		return 0;
+	}
+
+	packet.setSource(_address);
+	packet.setDestination(destination);
+
+	return encodeFrame(packet, scratch, frame);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_len_t SimpleCommLink::encodeFrame(SimplePacketBase &packet, uint8_t *scratch, const uint8_t *&frame) {
+	sp_len_t dataLength = packet.getDataLength();
+
+#ifdef SIMPLECOMM_DEBUG
+	Serial.print(F("Sending package from 0x")); Serial.print(packet.getSource(), HEX);
+	Serial.print(F(" to 0x")); Serial.println(packet.getDestination(), HEX);
+#endif
+
+#ifdef SP_COMPRESSION
+	if (_compressMin && dataLength >= _compressMin) {
+		// The frame is built in the scratch buffer, laid out as a packet
+		// buffer, so the packet keeps its payload
+		uint8_t *header = scratch + offsetof(SimplePacketBuffer, destination);
+		uint8_t *packed = header + SP_HDR_LEN;
+		sp_len_t packedLength = SimpleLZ::compress(packet.buffer()->data, dataLength, packed, dataLength - 1);
+		if (packedLength) {
+			memcpy(header, &packet.buffer()->destination, SP_HDR_LEN);
+			putCRC(packed + packedLength, SimpleCRC::calc(header, SP_HDR_LEN + packedLength));
+			return putHead(scratch, SP_SYN_COMPRESSED, PKT_LEN(packedLength), frame);
+		}
+	}
+#else
+	(void) scratch;
+#endif
+
+#if SP_CRC_MODE == SP_CRC_SUM
+	// addData() keeps the sum of the data, only the header is missing
+	sp_crc_t crc = SimpleCRC::update(packet._crc, &packet.buffer()->destination, SP_HDR_LEN);
+#else
+	// The header goes before the data, so the CRC can't be built while adding it
+	sp_crc_t crc = SimpleCRC::calc(&packet.buffer()->destination, SP_HDR_LEN + dataLength);
+#endif
+	putCRC(packet.buffer()->data + dataLength, crc);
+
+	return putHead((uint8_t*) packet.buffer(), 0, PKT_LEN(dataLength), frame);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint8_t *SimpleCommLink::encoded(const SimplePacketBase &packet, sp_len_t &length) {
+	const uint8_t *frame = frameIn((uint8_t*) packet.buffer());
+	length = headLen(frame[0]) + getLen(frame);
+	return frame;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_len_t SimpleCommLink::relay(SimplePacketBase &packet, uint8_t *scratch, const uint8_t *&frame) {
+#ifdef SP_COMPRESSION
+	if (frameIn((uint8_t*) packet.buffer())[0] & SP_SYN_COMPRESSED) {
+		// The payload was decompressed in place: the frame is gone
+		return encodeFrame(packet, scratch, frame);
+	}
+#else
+	(void) scratch;
+#endif
+
+	sp_len_t length;
+	frame = encoded(packet, length);
+	return length;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::receive(SimplePacketBase &packet) {
+	if (_rx.len > 0 && _rx.packet != &packet) {
+		// Carry the partial frame over to the new packet, unless it's too
+		// long for it
+		uint8_t *from = (uint8_t*) _rx.packet->buffer();
+		uint8_t *frame = frameIn(from);
+		if (_rx.len >= headLen(frame[0]) && !validLen(getLen(frame), packet._capacity)) {
+			SP_STAT(++_stats.lengthErrors);
+			SP_STAT(_stats.bytesDropped += _rx.len);
+			_rx.len = 0;
+		}
+		else {
+			memcpy(packet.buffer(), from, frame - from + _rx.len);
+		}
+	}
+
+	return parse(*_stream, packet, _rx);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::parse(Stream &stream, SimplePacketBase &packet, SimpleCommRxState &state) {
+#ifdef SP_STATS_LATENCY
+	// Only the calls that read bytes are timed, the idle ones would hide them
+	uint32_t bytes = _stats.bytesReceived;
+	unsigned long start = _clock();
+	bool ret = parseStream(stream, packet, state);
+	if (_stats.bytesReceived != bytes) {
+		unsigned long elapsed = (_clock() - start) >> 1;
+		uint8_t bucket = 0;
+		while (elapsed && bucket < SP_STATS_LATENCY_BUCKETS - 1) {
+			elapsed >>= 1;
+			++bucket;
+		}
+		++_stats.receiveTime[bucket];
+	}
+	return ret;
+#else
+	return parseStream(stream, packet, state);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::parseStream(Stream &stream, SimplePacketBase &packet, SimpleCommRxState &state) {
+	uint8_t* buffer = (uint8_t*) packet.buffer();
+
+	state.packet = &packet;
+
+	if (_interByteTimeout || _frameTimeout) {
+		if (!stream.available()) {
+			// Stale partial frames are dropped even when the line stays silent
+			checkTimeouts(state, _clock());
+			return false;
+		}
+
+		// The bytes read now are stamped with the time of this call
+		unsigned long now = _clock();
+		checkTimeouts(state, now);
+		state.lastByte = now;
+	}
+
+	if (_bulkRead) {
+		return parseBulk(stream, packet, state);
+	}
+
+	// Counted apart, as the statistics can't stay in registers across read()
+	SP_STAT(uint32_t received = 0);
+	int available;
+	while ((available = stream.available()) > 0) {
+		if (state.skip) {
+			if (skipFrame(stream, state, available) == 0) {
+				break;
+			}
+			continue;
+		}
+
+		uint8_t in = stream.read();
+		SP_STAT(++received);
+
+		if (state.len == 0) {
+			if (!isSyn(in)) {
+#ifdef SIMPLECOMM_DEBUG
+				Serial.print(F("Unsynchronized. Byte received was: "));
+				Serial.println(in, HEX);
+#endif
+				SP_STAT(++_stats.bytesDropped);
+				continue;
+			}
+
+			startFrame(packet, state, buffer, in);
+			continue;
+		}
+
+		uint8_t* rxBuffer = frameIn(buffer);
+		sp_len_t pos = state.len++;
+		rxBuffer[pos] = in;
+
+		uint8_t head = headLen(rxBuffer[0]);
+		if (state.len == head) {
+			sp_len_t tlen = getLen(rxBuffer);
+			if (!validLen(tlen, packet._capacity)) {
+#ifdef SIMPLECOMM_DEBUG
+				Serial.print(F("Invalid data length: "));
+				Serial.println(tlen);
+#endif
+				SP_STAT(++_stats.lengthErrors);
+				SP_STAT(_stats.bytesDropped += state.len - 1);
+				state.len = 0;
+				if (_resync && isSyn(in)) {
+					// The rejected length may be the SYN of the next frame
+					startFrame(packet, state, buffer, in);
+				}
+				else {
+					SP_STAT(++_stats.bytesDropped);
+				}
+			}
+			continue;
+		}
+
+		if (_earlyFilter && state.len == head + SP_DST_LEN && !accepts(in)) {
+			rejectFrame(state, head + getLen(rxBuffer));
+			continue;
+		}
+
+		if (state.len > head) {
+			// Update the check while the bytes arrive, so completing the frame is O(1)
+			sp_len_t tlen = getLen(rxBuffer);
+			if (pos < head + tlen - SP_CRC_LEN) {
+				state.crc = SimpleCRC::update(state.crc, in);
+			}
+
+			if (state.len == head + tlen) {
+				// Buffer complete
+				if (completeFrame(packet, state)) {
+					SP_STAT(_stats.bytesReceived += received);
+					return true;
+				}
+			}
+		}
+	}
+
+	SP_STAT(_stats.bytesReceived += received);
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::parseBulk(Stream &stream, SimplePacketBase &packet, SimpleCommRxState &state) {
+	uint8_t* buffer = (uint8_t*) packet.buffer();
+
+	// With early filtering the DST byte is read with the head, to be checked first
+	uint8_t early = _earlyFilter ? SP_DST_LEN : 0;
+
+	int available = stream.available();
+	while (available > 0) {
+		if (state.skip) {
+			sp_len_t count = skipFrame(stream, state, available);
+			if (count == 0) {
+				break;
+			}
+			available -= count;
+			continue;
+		}
+
+		// Until its SYN is known, a frame is read where the short ones start
+		uint8_t* rxBuffer = state.len ? frameIn(buffer) : buffer + SP_LEN_EXT_LEN;
+
+		// Never read beyond the current frame, so the bytes of the next one stay in the stream
+		sp_len_t wanted;
+		if (state.len < SP_SYN_LEN + SP_LEN_LEN) {
+			wanted = SP_SYN_LEN + SP_LEN_LEN + early - state.len;
+		}
+		else if (state.len < headLen(rxBuffer[0]) + early) {
+			wanted = headLen(rxBuffer[0]) + early - state.len;
+		}
+		else {
+			wanted = headLen(rxBuffer[0]) + getLen(rxBuffer) - state.len;
+		}
+		if (wanted > available) {
+			wanted = available;
+		}
+
+		sp_len_t first = state.len;
+		sp_len_t count = stream.readBytes(rxBuffer + first, wanted);
+		if (count == 0) {
+			break;
+		}
+		SP_STAT(_stats.bytesReceived += count);
+		available -= count;
+		state.len += count;
+
+		if (first == 0) {
+			// Skip everything before the first SYN
+#if SP_SYN_FLAGS
+			sp_len_t skip = 0;
+			while (skip < state.len && !isSyn(rxBuffer[skip])) {
+				++skip;
+			}
+#else
+			const uint8_t* syn = (const uint8_t*) memchr(rxBuffer, SP_SYN_VALUE, state.len);
+			sp_len_t skip = syn ? syn - rxBuffer : state.len;
+#endif
+			if (skip) {
+#ifdef SIMPLECOMM_DEBUG
+				Serial.print(F("Unsynchronized. Bytes skipped: "));
+				Serial.println(skip);
+#endif
+				SP_STAT(_stats.bytesDropped += skip);
+				state.len -= skip;
+			}
+			rxBuffer = placeFrame(buffer, rxBuffer + skip, state.len);
+		}
+
+		uint8_t head = headLen(rxBuffer[0]);
+		if (state.len < head) {
+			continue;
+		}
+
+		sp_len_t tlen = getLen(rxBuffer);
+		if (!validLen(tlen, packet._capacity)) {
+#ifdef SIMPLECOMM_DEBUG
+			Serial.print(F("Invalid data length: "));
+			Serial.println(tlen);
+#endif
+			SP_STAT(++_stats.lengthErrors);
+			if (_resync) {
+				// The rejected length may be the SYN of the next frame
+				resync(packet, state);
+			}
+			else {
+				SP_STAT(_stats.bytesDropped += state.len);
+				state.len = 0;
+			}
+			continue;
+		}
+
+		// Update the check with the new bytes while they are still hot in the cache
+		if (first < head) {
+			// The previous content of the packet is being overwritten
+			packet.clear();
+			state.crc = SP_CRC_INIT;
+			state.frameStart = state.lastByte;
+			first = head;
+		}
+		if (early && first == head && state.len > head && !accepts(rxBuffer[head])) {
+			rejectFrame(state, head + tlen);
+			continue;
+		}
+		sp_len_t last = head + tlen - SP_CRC_LEN;
+		if (last > state.len) {
+			last = state.len;
+		}
+		if (last > first) {
+			state.crc = SimpleCRC::update(state.crc, rxBuffer + first, last - first);
+		}
+
+		if (state.len == head + tlen) {
+			// Buffer complete
+			if (completeFrame(packet, state)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::completeFrame(SimplePacketBase &packet, SimpleCommRxState &state) {
+	uint8_t* buffer = (uint8_t*) packet.buffer();
+
+	// After a resynchronisation the next candidate may be already complete
+	while (state.len >= SP_SYN_LEN + SP_LEN_LEN) {
+		uint8_t* rxBuffer = frameIn(buffer);
+		uint8_t head = headLen(rxBuffer[0]);
+		if (state.len < head) {
+			return false;
+		}
+		sp_len_t tlen = getLen(rxBuffer);
+		sp_len_t total = head + tlen;
+		if (state.len < total) {
+			return false;
+		}
+		if (state.len > total) {
+			// Bytes buffered beyond a resynchronised frame can't be kept
+			SP_STAT(_stats.bytesDropped += state.len - total);
+			state.len = total;
+		}
+
+		// Check CRC
+		sp_crc_t receivedCrc = getCRC(rxBuffer + total - SP_CRC_LEN);
+		if (receivedCrc != state.crc) {
+#ifdef SIMPLECOMM_DEBUG
+			Serial.print(F("Invalid CRC: "));
+			Serial.print(receivedCrc, HEX);
+			Serial.print(F(" != "));
+			Serial.print(state.crc, HEX);
+			Serial.println();
+			printBuff(rxBuffer, total);
+#endif
+			SP_STAT(++_stats.crcErrors);
+			if (_resync) {
+				resync(packet, state);
+				continue;
+			}
+			SP_STAT(_stats.bytesDropped += state.len);
+			state.len = 0;
+			return false;
+		}
+
+		state.len = 0;
+
+		// Check destination
+		if (!accepts(packet.buffer()->destination)) {
+#ifdef SIMPLECOMM_DEBUG
+			Serial.print(F("Received package it's not for me, it was for 0x"));
+			Serial.println(packet.buffer()->destination, HEX);
+#endif
+			SP_STAT(++_stats.addressRejects);
+			return false;
+		}
+
+		packet._dataLen = tlen - SP_HDR_LEN - SP_CRC_LEN;
+#ifdef SP_COMPRESSION
+		if (rxBuffer[0] & SP_SYN_COMPRESSED) {
+			// Payloads that would not fit in the packet are invalid too
+			uint8_t plain[SP_MAX_DATA_LEN];
+			sp_len_t plainLength = SimpleLZ::decompress(packet.buffer()->data, packet._dataLen, plain, packet._capacity);
+			if (plainLength == 0) {
+#ifdef SIMPLECOMM_DEBUG
+				Serial.println(F("Invalid compressed payload"));
+#endif
+				SP_STAT(++_stats.formatErrors);
+				packet._dataLen = 0;
+				return false;
+			}
+			memcpy(packet.buffer()->data, plain, plainLength);
+			packet._dataLen = plainLength;
+#if SP_CRC_MODE == SP_CRC_SUM
+			packet._crc = SimpleCRC::sum(0, packet.buffer()->data, plainLength);
+#endif
+		}
+		else
+#endif
+		{
+#if SP_CRC_MODE == SP_CRC_SUM
+			// Keep only the sum of the data, as addData() does
+			packet._crc = state.crc - SimpleCRC::sum(0, &packet.buffer()->destination, SP_HDR_LEN);
+#endif
+		}
+#ifdef SIMPLECOMM_DEBUG
+		Serial.print(F("Good package with len "));
+		Serial.print(packet._dataLen);
+		Serial.print(F(": "));
+		printBuff(packet.buffer()->data, packet._dataLen);
+		Serial.println();
+#endif
+		SP_STAT(++_stats.packetsReceived);
+
+		return true;
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::resync(SimplePacketBase &packet, SimpleCommRxState &state) {
+	uint8_t* buffer = (uint8_t*) packet.buffer();
+	uint8_t* rxBuffer = frameIn(buffer);
+
+	// Look for the next SYN followed by a valid length in the buffered bytes,
+	// instead of throwing away a frame that may start inside the bad one
+	sp_len_t skip = 1;
+	for (; skip < state.len; ++skip) {
+		if (!isSyn(rxBuffer[skip])) {
+			continue;
+		}
+		if ((skip + headLen(rxBuffer[skip]) <= state.len) && !validLen(getLen(rxBuffer + skip), packet._capacity)) {
+			continue;
+		}
+		break;
+	}
+
+#ifdef SIMPLECOMM_DEBUG
+	Serial.print(F("Resynchronised. Bytes skipped: "));
+	Serial.println(skip);
+#endif
+	SP_STAT(_stats.bytesDropped += skip);
+	state.len -= skip;
+	rxBuffer = placeFrame(buffer, rxBuffer + skip, state.len);
+
+	// The check has to be rebuilt over the bytes of the new candidate
+	state.crc = SP_CRC_INIT;
+	uint8_t head = headLen(rxBuffer[0]);
+	if (state.len > head) {
+		sp_len_t last = head + getLen(rxBuffer) - SP_CRC_LEN;
+		if (last > state.len) {
+			last = state.len;
+		}
+		state.crc = SimpleCRC::update(SP_CRC_INIT, rxBuffer + head, last - head);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommLink::accepts(uint8_t destination) const {
+	// if my address is 0 then receive all messages
+	// if destination address is 0 then it is a broadcast message
+	return _address == 0
+	    || destination == 0
+	    || ((destination ^ _address) & _addressMask) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::rejectFrame(SimpleCommRxState &state, sp_len_t total) {
+#ifdef SIMPLECOMM_DEBUG
+	Serial.print(F("Skipping a frame for another address. Bytes: "));
+	Serial.println(total);
+#endif
+	SP_STAT(++_stats.addressRejects);
+	state.skip = total - state.len;
+	state.len = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_len_t SimpleCommLink::skipFrame(Stream &stream, SimpleCommRxState &state, int available) {
+	// The bytes go through a small buffer, so the packet is not touched
+	uint8_t scratch[SKIP_CHUNK_LEN];
+	sp_len_t skipped = 0;
+	while (state.skip > 0 && available > 0) {
+		sp_len_t wanted = state.skip < SKIP_CHUNK_LEN ? state.skip : SKIP_CHUNK_LEN;
+		if (wanted > available) {
+			wanted = available;
+		}
+		sp_len_t count = stream.readBytes(scratch, wanted);
+		if (count == 0) {
+			break;
+		}
+		SP_STAT(_stats.bytesReceived += count);
+		state.skip -= count;
+		available -= count;
+		skipped += count;
+	}
+	return skipped;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommLink::checkTimeouts(SimpleCommRxState &state, unsigned long now) {
+	if (state.len == 0 && state.skip == 0) {
+		return;
+	}
+
+	if ((_interByteTimeout && (now - state.lastByte > _interByteTimeout))
+	    || (_frameTimeout && (now - state.frameStart > _frameTimeout))) {
+#ifdef SIMPLECOMM_DEBUG
+		Serial.print(F("Timeout. Bytes dropped: "));
+		Serial.println(state.len);
+#endif
+		SP_STAT(++_stats.timeouts);
+		SP_STAT(_stats.bytesDropped += state.len);
+		state.len = 0;
+		state.skip = 0;
+	}
+}
@@ -0,0 +1,223 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleCommLink_H__
+#define __SimpleCommLink_H__
+
+#include <Arduino.h>
+
+#include "SimplePacket.h"
+#include "SimpleCommPool.h"
+#include "SimpleCRC.h"
+
+
+// Buckets of the receive() time histogram: bucket i counts the calls that
+// took less than 2^(i+1) microseconds, the last one the longer ones
+#define SP_STATS_LATENCY_BUCKETS 8
+
+// Packet type of exported statistics
+#ifndef SP_STATS_TYPE
+#define SP_STATS_TYPE 0xF2
+#endif
+
+// The histogram is part of the statistics
+#if !SP_STATS
+#undef SP_STATS_LATENCY
+#endif
+
+// Counts into the link statistics, unless they are compiled out
+#if SP_STATS
+#define SP_STAT(statement) statement
+#else
+#define SP_STAT(statement)
+#endif
+
+typedef struct {
+	uint32_t packetsReceived;
+	uint32_t packetsSent;
+	// Bytes read from and written to the stream
+	uint32_t bytesReceived;
+	uint32_t bytesSent;
+	uint32_t crcErrors;
+	uint32_t lengthErrors;
+	uint32_t addressRejects;
+	uint32_t bytesDropped;
+	uint32_t timeouts;
+	uint32_t formatErrors;
+#ifdef SP_STATS_LATENCY
+	uint32_t receiveTime[SP_STATS_LATENCY_BUCKETS];
+#endif
+} SimpleCommStats;
+
+// State of a frame being received
+typedef struct {
+	SimplePacketBase *packet;
+	sp_len_t len;
+	sp_len_t skip;
+	sp_crc_t crc;
+	unsigned long frameStart;
+	unsigned long lastByte;
+} SimpleCommRxState;
+
+// Time source of the receive timeouts, in microseconds
+typedef unsigned long (*SimpleCommClock)();
+
+// Bytes the queues write per call to a stream that never reported room:
+// streams that don't implement availableForWrite() always report 0
+#ifndef SP_WRITE_LIMIT
+#define SP_WRITE_LIMIT 64
+#endif
+
+// Room for a frame built outside of its packet (compressed payloads)
+#ifdef SP_COMPRESSION
+#define SP_FRAME_SCRATCH_LEN SP_BUFFER_SIZE
+#else
+#define SP_FRAME_SCRATCH_LEN 1
+#endif
+
+
+// One SimpleComm endpoint on one Stream, with its own address, parser
+// state and statistics. Several links can be serviced from the same loop,
+// e.g. two RS-485 ports and an Ethernet client, without sharing any state.
+class SimpleCommLink {
+public:
+	friend class SimpleCommClass;
+	friend class SimpleCommTxQueue;
+	friend class SimpleCommBatch;
+	friend class SimpleCommFragmenter;
+	friend class SimpleCommReassembler;
+	friend class SimpleCommReliable;
+	friend class SimpleCommScheduler;
+	friend class SimpleCommRouter;
+	friend class SimpleCommPacketQueue;
+
+	explicit SimpleCommLink(Stream &stream, uint8_t address = 0);
+
+public:
+	void begin(uint8_t address = 0);
+	uint8_t getAddress() const;
+	Stream &getStream() const;
+
+	// Bits of the destination compared with the address (0xFF by default).
+	// A link with address 0x10 and mask 0xF0 accepts 0x10 to 0x1F, so a
+	// node can own a group of addresses. Broadcasts are always accepted.
+	void setAddressMask(uint8_t mask);
+	uint8_t getAddressMask() const;
+
+	// Early address filtering (disabled by default): a frame for another
+	// address is rejected as soon as its DST byte arrives, and the rest of
+	// it is read and dropped by its length without being buffered or
+	// checked. Frames are not checked before being skipped, so a corrupted
+	// LEN can hide the next frame, until a receive timeout if they are set.
+	void setEarlyFilter(bool enabled);
+	bool getEarlyFilter() const;
+
+	bool send(SimplePacketBase &packet, uint8_t destination = 0);
+	bool send(SimplePacketBase &packet, uint8_t destination, uint8_t type);
+
+	// Parses the available bytes into the packet and returns true when it
+	// holds a complete packet. A frame cut between calls stays in the
+	// packet, and is copied from it when the next call is made with another
+	// packet: until then, the packet must be neither destroyed nor changed.
+	bool receive(SimplePacketBase &packet);
+
+	// Bulk read mode: drain the stream with readBytes() instead of one read() per byte
+	void setBulkRead(bool enabled);
+	bool getBulkRead() const;
+
+	// Resynchronisation (enabled by default): after a CRC error, look for
+	// the next frame inside the discarded bytes instead of dropping them all
+	void setResync(bool enabled);
+	bool getResync() const;
+
+	// Receive timeouts, in microseconds (0 disables them, the default). A
+	// partial frame is dropped when no byte arrived for interByteTimeout or
+	// the frame has been arriving for longer than frameTimeout. Gaps are
+	// measured between calls to receive(), so it must be polled faster
+	// than the timeouts.
+	void setTimeouts(unsigned long interByteTimeout, unsigned long frameTimeout = 0);
+	unsigned long getInterByteTimeout() const;
+	unsigned long getFrameTimeout() const;
+
+	// Clock of the timeouts, micros() by default
+	void setClock(SimpleCommClock clock);
+
+#ifdef SP_COMPRESSION
+	// Payloads of at least minLength bytes are sent compressed, when that
+	// makes them shorter (0 disables it, the default). Compressed frames
+	// are always accepted.
+	void setCompression(uint8_t minLength);
+	uint8_t getCompression() const;
+#endif
+
+	const SimpleCommStats &getStats() const;
+	void resetStats();
+
+	// Pool whose occupancy is exported with the statistics (none by default)
+	void setPool(const SimpleCommPacketPool *pool);
+
+	// Statistics as a packet of type SP_STATS_TYPE, to be polled remotely:
+	// the number of counters, the counters in the order of SimpleCommStats
+	// (32 bits, little endian), then the number of histogram buckets and the
+	// buckets (none without SP_STATS_LATENCY), then the number of pool
+	// counters and the counters in the order of SimpleCommPoolStats (none
+	// without a pool). Returns false when they are compiled out.
+	bool exportStats(SimplePacketBase &packet) const;
+	// Reads exported statistics. Counters missing from the packet are 0.
+	static bool importStats(const SimplePacketBase &packet, SimpleCommStats &stats, SimpleCommPoolStats *pool = NULL);
+
+private:
+	explicit SimpleCommLink();
+
+	bool send(Stream &stream, SimplePacketBase &packet, uint8_t destination);
+	sp_len_t encode(SimplePacketBase &packet, uint8_t destination, uint8_t *scratch, const uint8_t *&frame);
+	sp_len_t encodeFrame(SimplePacketBase &packet, uint8_t *scratch, const uint8_t *&frame);
+	static const uint8_t *encoded(const SimplePacketBase &packet, sp_len_t &length);
+	// Frame of a received packet: the one it arrived in, when still intact
+	// (cut-through), or encoded again with the header of the packet
+	sp_len_t relay(SimplePacketBase &packet, uint8_t *scratch, const uint8_t *&frame);
+	bool parse(Stream &stream, SimplePacketBase &packet, SimpleCommRxState &state);
+	bool parseStream(Stream &stream, SimplePacketBase &packet, SimpleCommRxState &state);
+	bool parseBulk(Stream &stream, SimplePacketBase &packet, SimpleCommRxState &state);
+	bool completeFrame(SimplePacketBase &packet, SimpleCommRxState &state);
+	void resync(SimplePacketBase &packet, SimpleCommRxState &state);
+	void checkTimeouts(SimpleCommRxState &state, unsigned long now);
+	bool accepts(uint8_t destination) const;
+	void rejectFrame(SimpleCommRxState &state, sp_len_t total);
+	sp_len_t skipFrame(Stream &stream, SimpleCommRxState &state, int available);
+
+private:
+	Stream *_stream;
+	uint8_t _address;
+	uint8_t _addressMask;
+	bool _earlyFilter;
+	bool _bulkRead;
+	bool _resync;
+	unsigned long _interByteTimeout;
+	unsigned long _frameTimeout;
+	SimpleCommClock _clock;
+#ifdef SP_COMPRESSION
+	uint8_t _compressMin;
+#endif
+	SimpleCommRxState _rx;
+#if SP_STATS
+	SimpleCommStats _stats;
+#endif
+	const SimpleCommPacketPool *_pool;
+};
+
+#endif // __SimpleCommLink_H__
@@ -0,0 +1,193 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommPacketQueue.h"
+#include "SimpleAtomic.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommPacketQueue::SimpleCommPacketQueue(SimpleCommPacketRef *slots, bool *relay, uint8_t size) {
+	// The slots may not be constructed yet (SimpleCommPacketQueueBuffer): don't touch them
+	_slots = slots;
+	_relay = relay;
+	_size = size;
+	_head = 0;
+	_tail = 0;
+	_frame = NULL;
+	_frameLen = 0;
+	_offset = 0;
+	_writeLimit = SP_WRITE_LIMIT;
+	_reportsRoom = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommPacketQueue::push(const SimpleCommPacketRef &packet) {
+	return push(packet, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommPacketQueue::forward(const SimpleCommPacketRef &packet) {
+	return push(packet, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommPacketQueue::receive(SimpleCommLink &link, SimpleCommPacketPool &pool) {
+	uint8_t received = 0;
+
+	while (true) {
+		uint8_t tail = _tail;
+		if (next(tail) == SimpleAtomic::load(_head)) {
+			break;
+		}
+		if (_pending.isNull()) {
+			_pending = pool.alloc();
+			if (_pending.isNull()) {
+				break;
+			}
+		}
+
+		// A partial frame stays in the pending packet until the next call
+		if (!link.receive(*_pending)) {
+			break;
+		}
+
+		// The reference moves to the queue, without touching the count
+		_slots[tail] = static_cast<SimpleCommPacketRef&&>(_pending);
+		_relay[tail] = true;
+		SimpleAtomic::store(_tail, next(tail));
+		++received;
+	}
+
+	return received;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleCommPacketRef *SimpleCommPacketQueue::peek() const {
+	uint8_t head = _head;
+	return head != SimpleAtomic::load(_tail) ? &_slots[head] : NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommPacketQueue::pop() {
+	uint8_t head = _head;
+	if (head == SimpleAtomic::load(_tail)) {
+		return;
+	}
+
+	_slots[head].release();
+	_frame = NULL;
+	_offset = 0;
+	SimpleAtomic::store(_head, next(head));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommPacketQueue::transmit(SimpleCommLink &link) {
+	Stream &stream = link.getStream();
+	int room = stream.availableForWrite();
+	if (room > 0) {
+		_reportsRoom = true;
+	}
+	else if (!_reportsRoom) {
+		room = _writeLimit;
+	}
+
+	uint8_t sent = 0;
+	while (room > 0) {
+		uint8_t head = _head;
+		if (head == SimpleAtomic::load(_tail)) {
+			break;
+		}
+
+		if (!_frame) {
+			// Encoded when it starts to be written. A forwarded packet keeps
+			// the frame it arrived in, which every queue sharing it reads.
+			if (_relay[head]) {
+				_frameLen = link.relay(*_slots[head], _scratch, _frame);
+			}
+			else {
+				_frameLen = link.encodeFrame(*_slots[head], _scratch, _frame);
+			}
+		}
+
+		sp_len_t wanted = _frameLen - _offset;
+		if (wanted > room) {
+			wanted = room;
+		}
+
+		size_t written = stream.write(_frame + _offset, wanted);
+		SP_STAT(link._stats.bytesSent += written);
+		room -= written;
+		_offset += written;
+		if (_offset < _frameLen) {
+			// The rest of the frame goes on the next call
+			break;
+		}
+
+		SP_STAT(++link._stats.packetsSent);
+		++sent;
+		pop();
+	}
+
+	return sent;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommPacketQueue::setWriteLimit(uint8_t limit) {
+	_writeLimit = limit;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommPacketQueue::available() const {
+	uint8_t head = SimpleAtomic::load(_head);
+	uint8_t tail = SimpleAtomic::load(_tail);
+	return tail >= head ? tail - head : _size - head + tail;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommPacketQueue::isEmpty() const {
+	return SimpleAtomic::load(_head) == SimpleAtomic::load(_tail);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommPacketQueue::isFull() const {
+	return next(SimpleAtomic::load(_tail)) == SimpleAtomic::load(_head);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommPacketQueue::clear() {
+	while (!isEmpty()) {
+		pop();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommPacketQueue::push(const SimpleCommPacketRef &packet, bool relay) {
+	uint8_t tail = _tail;
+	if (packet.isNull() || next(tail) == SimpleAtomic::load(_head)) {
+		return false;
+	}
+
+	// The slot is filled before the consumer can see it
+	_slots[tail] = packet;
+	_relay[tail] = relay;
+	SimpleAtomic::store(_tail, next(tail));
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommPacketQueue::next(uint8_t index) const {
+	return index + 1 < _size ? index + 1 : 0;
+}
@@ -0,0 +1,110 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleCommPacketQueue_H__
+#define __SimpleCommPacketQueue_H__
+
+#include "SimpleCommLink.h"
+#include "SimpleCommPool.h"
+
+
+// FIFO of packets of a SimpleCommPacketPool, by reference: a packet is
+// received, queued and sent in place, and pushing it to several queues
+// shares it instead of copying it. One producer (push(), receive()) and
+// one consumer (pop(), transmit()), e.g. an interrupt and the main loop,
+// can use a queue at the same time without locks.
+class SimpleCommPacketQueue {
+public:
+	// One of the slots is always empty: size is the capacity plus one
+	explicit SimpleCommPacketQueue(SimpleCommPacketRef *slots, bool *relay, uint8_t size);
+
+	// Queues a reference to the packet. Returns false when the queue is
+	// full or the reference is null.
+	bool push(const SimpleCommPacketRef &packet);
+
+	// Queues a reference to a received packet, sent as it arrived, source
+	// included. Its frame is not encoded again unless it was compressed, and
+	// the packet must not be changed while it is queued.
+	bool forward(const SimpleCommPacketRef &packet);
+
+	// Receives packets from the link into packets taken from the pool and
+	// queues them, as forward() would, until the stream is drained, the queue is full or the
+	// pool is empty. Returns the number of packets queued. The queue keeps
+	// one packet of the pool for the next frame between calls.
+	uint8_t receive(SimpleCommLink &link, SimpleCommPacketPool &pool);
+
+	// Oldest packet, or NULL when there is none. It can be copied to share
+	// the packet, e.g. with another queue.
+	const SimpleCommPacketRef *peek() const;
+	// Drops the oldest packet, even if transmit() has written part of it
+	void pop();
+
+	// Writes the queued packets to the link, with the header they have
+	// (set the source of new ones), never more bytes than the stream can
+	// take at once. Returns the number of frames
+	// completely written, which are popped.
+	uint8_t transmit(SimpleCommLink &link);
+
+	// Streams that don't implement availableForWrite() report 0, as full
+	// ones do. Until a stream reports room, transmit() writes up to limit
+	// bytes per call instead (SP_WRITE_LIMIT by default, 0 waits for room).
+	void setWriteLimit(uint8_t limit);
+
+	uint8_t available() const;
+	bool isEmpty() const;
+	bool isFull() const;
+
+	void clear();
+
+private:
+	bool push(const SimpleCommPacketRef &packet, bool relay);
+	uint8_t next(uint8_t index) const;
+
+private:
+	SimpleCommPacketRef *_slots;
+	// Slots sent with the frame they arrived in
+	bool *_relay;
+	uint8_t _size;
+	volatile uint8_t _head;
+	volatile uint8_t _tail;
+	// Packet being received, kept between calls: it may hold a partial frame
+	SimpleCommPacketRef _pending;
+	// Frame of the oldest packet being written
+	const uint8_t *_frame;
+	sp_len_t _frameLen;
+	sp_len_t _offset;
+	uint8_t _writeLimit;
+	// The stream implements availableForWrite()
+	bool _reportsRoom;
+	uint8_t _scratch[SP_FRAME_SCRATCH_LEN];
+};
+
+// SimpleCommPacketQueue owning room for N references
+template <uint8_t N>
+class SimpleCommPacketQueueBuffer : public SimpleCommPacketQueue {
+public:
+	static_assert(N < 0xFF, "Too many slots");
+
+	explicit SimpleCommPacketQueueBuffer() : SimpleCommPacketQueue(_refs, _relay, N + 1) {
+	}
+
+private:
+	SimpleCommPacketRef _refs[N + 1];
+	bool _relay[N + 1];
+};
+
+#endif // __SimpleCommPacketQueue_H__
@@ -0,0 +1,155 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommPool.h"
+#include "SimpleAtomic.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommPacketRef::SimpleCommPacketRef(const SimpleCommPacketRef &ref) :
+		_pool(ref._pool), _packet(ref._packet), _index(ref._index) {
+	if (_packet) {
+		_pool->retain(_index);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommPacketRef::SimpleCommPacketRef(SimpleCommPacketRef &&ref) :
+		_pool(ref._pool), _packet(ref._packet), _index(ref._index) {
+	ref._pool = NULL;
+	ref._packet = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommPacketRef::~SimpleCommPacketRef() {
+	release();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommPacketRef &SimpleCommPacketRef::operator=(const SimpleCommPacketRef &ref) {
+	// Taken before letting go of the current one, which may be the same packet
+	if (ref._packet) {
+		ref._pool->retain(ref._index);
+	}
+	release();
+	_pool = ref._pool;
+	_packet = ref._packet;
+	_index = ref._index;
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommPacketRef &SimpleCommPacketRef::operator=(SimpleCommPacketRef &&ref) {
+	if (&ref != this) {
+		release();
+		_pool = ref._pool;
+		_packet = ref._packet;
+		_index = ref._index;
+		ref._pool = NULL;
+		ref._packet = NULL;
+	}
+	return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommPacketRef::release() {
+	if (_packet) {
+		_pool->release(_index);
+		_pool = NULL;
+		_packet = NULL;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommPacketRef::refs() const {
+	return _packet ? SimpleAtomic::load(_pool->_refs[_index]) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommPacketPool::init(SimplePacketBase *packets, uint16_t stride, volatile uint8_t *refs, uint8_t size) {
+	// The packets and their counts may not be constructed yet
+	// (SimpleCommPacketPoolBuffer): don't touch them
+	_packets = packets;
+	_stride = stride;
+	_refs = refs;
+	_next = 0;
+	memset(&_stats, 0, sizeof(_stats));
+	_stats.size = size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommPacketRef SimpleCommPacketPool::alloc() {
+	// Packets are claimed by their count, so an interrupt taking one in the
+	// middle of the search only makes it look further
+	uint8_t size = _stats.size;
+	uint8_t index = SimpleAtomic::load(_next);
+	for (uint8_t i = 0; i < size; ++i) {
+		if (SimpleAtomic::compareExchange(_refs[index], (uint8_t) 0, (uint8_t) 1)) {
+			// Only a hint: a race makes the next search a bit longer
+			SimpleAtomic::store(_next, (uint8_t) (index + 1 < size ? index + 1 : 0));
+
+			uint8_t used = SimpleAtomic::add(_stats.used, (uint8_t) 1);
+			uint8_t peak = SimpleAtomic::load(_stats.peak);
+			while (used > peak && !SimpleAtomic::compareExchange(_stats.peak, peak, used)) {
+				peak = SimpleAtomic::load(_stats.peak);
+			}
+
+			SimplePacketBase *p = packet(index);
+			p->clear();
+			return SimpleCommPacketRef(this, p, index);
+		}
+
+		if (++index == size) {
+			index = 0;
+		}
+	}
+
+	SimpleAtomic::add(_stats.failures, (uint16_t) 1);
+	return SimpleCommPacketRef();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommPacketPool::available() const {
+	return _stats.size - SimpleAtomic::load(_stats.used);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleCommPoolStats &SimpleCommPacketPool::getStats() const {
+	return _stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommPacketPool::resetStats() {
+	SimpleAtomic::store(_stats.failures, (uint16_t) 0);
+	SimpleAtomic::store(_stats.peak, SimpleAtomic::load(_stats.used));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimplePacketBase *SimpleCommPacketPool::packet(uint8_t index) {
+	return (SimplePacketBase*) ((uint8_t*) _packets + index * _stride);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommPacketPool::retain(uint8_t index) {
+	SimpleAtomic::add(_refs[index], (uint8_t) 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommPacketPool::release(uint8_t index) {
+	if (SimpleAtomic::sub(_refs[index], (uint8_t) 1) == 0) {
+		SimpleAtomic::sub(_stats.used, (uint8_t) 1);
+	}
+}
@@ -0,0 +1,136 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleCommPool_H__
+#define __SimpleCommPool_H__
+
+#include "SimplePacket.h"
+
+class SimpleCommPacketPool;
+
+typedef struct {
+	uint8_t size;
+	uint8_t used;
+	// Most packets in use at once
+	uint8_t peak;
+	// Allocations that found the pool empty
+	uint16_t failures;
+} SimpleCommPoolStats;
+
+// Reference to a packet of a SimpleCommPacketPool. Copies share the packet,
+// which returns to the pool when the last of them is released or destroyed.
+// A reference must not be used from an interrupt and the main loop at the
+// same time, but its copies can.
+class SimpleCommPacketRef {
+public:
+	friend class SimpleCommPacketPool;
+
+	SimpleCommPacketRef() : _pool(NULL), _packet(NULL), _index(0) {
+	}
+	SimpleCommPacketRef(const SimpleCommPacketRef &ref);
+	SimpleCommPacketRef(SimpleCommPacketRef &&ref);
+	~SimpleCommPacketRef();
+
+	SimpleCommPacketRef &operator=(const SimpleCommPacketRef &ref);
+	SimpleCommPacketRef &operator=(SimpleCommPacketRef &&ref);
+
+	// Drops the reference, leaving it null
+	void release();
+
+	bool isNull() const {
+		return _packet == NULL;
+	}
+
+	// References to the packet, this one included
+	uint8_t refs() const;
+
+	SimplePacketBase *get() const {
+		return _packet;
+	}
+	SimplePacketBase *operator->() const {
+		return _packet;
+	}
+	SimplePacketBase &operator*() const {
+		return *_packet;
+	}
+
+private:
+	SimpleCommPacketRef(SimpleCommPacketPool *pool, SimplePacketBase *packet, uint8_t index) :
+			_pool(pool), _packet(packet), _index(index) {
+	}
+
+private:
+	SimpleCommPacketPool *_pool;
+	SimplePacketBase *_packet;
+	uint8_t _index;
+};
+
+// Fixed set of packets handed out by reference, so packets can be queued,
+// shared and passed between the parser, queues and senders without being
+// copied, and without the heap. alloc() and the references are safe to use
+// from interrupts: a packet is claimed by setting its reference count from
+// 0 to 1 atomically, without locks.
+class SimpleCommPacketPool {
+public:
+	friend class SimpleCommPacketRef;
+
+	template <sp_len_t C>
+	explicit SimpleCommPacketPool(BasicSimplePacket<C> *packets, volatile uint8_t *refs, uint8_t size) {
+		init(packets, sizeof(BasicSimplePacket<C>), refs, size);
+	}
+
+	// Takes a free packet, cleared, or returns a null reference when there
+	// is none
+	SimpleCommPacketRef alloc();
+
+	uint8_t available() const;
+
+	// Occupancy of the pool, also exported with the statistics of the links
+	// it is set to (SimpleCommLink::setPool())
+	const SimpleCommPoolStats &getStats() const;
+	// Clears the failures, and the peak down to the packets in use
+	void resetStats();
+
+private:
+	void init(SimplePacketBase *packets, uint16_t stride, volatile uint8_t *refs, uint8_t size);
+	SimplePacketBase *packet(uint8_t index);
+	void retain(uint8_t index);
+	void release(uint8_t index);
+
+private:
+	SimplePacketBase *_packets;
+	uint16_t _stride;
+	volatile uint8_t *_refs;
+	// Where the search for a free packet starts
+	volatile uint8_t _next;
+	// Updated atomically
+	SimpleCommPoolStats _stats;
+};
+
+// SimpleCommPacketPool owning its N packets, of CAPACITY bytes of payload
+template <uint8_t N, sp_len_t CAPACITY = SP_MAX_DATA_LEN>
+class SimpleCommPacketPoolBuffer : public SimpleCommPacketPool {
+public:
+	explicit SimpleCommPacketPoolBuffer() : SimpleCommPacketPool(_packets, _refs, N), _refs() {
+	}
+
+private:
+	BasicSimplePacket<CAPACITY> _packets[N];
+	volatile uint8_t _refs[N];
+};
+
+#endif // __SimpleCommPool_H__
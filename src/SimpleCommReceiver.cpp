@@ -0,0 +1,89 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommReceiver.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReceiver::init(SimplePacketBase *slots, uint16_t stride, uint8_t capacity) {
+	// The slots may not be constructed yet (SimpleCommReceiverBuffer): don't touch them
+	_slots = slots;
+	_stride = stride;
+	_capacity = capacity;
+	_head = 0;
+	_count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommReceiver::poll() {
+	uint8_t received = 0;
+
+	while (_count < _capacity) {
+		uint8_t tail = _head + _count;
+		if (tail >= _capacity) {
+			tail -= _capacity;
+		}
+
+		// A partial frame stays in the tail slot until the next call
+		if (!_link.receive(*slot(tail))) {
+			break;
+		}
+
+		++_count;
+		++received;
+	}
+
+	return received;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommReceiver::available() const {
+	return _count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReceiver::isFull() const {
+	return _count == _capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimplePacketBase *SimpleCommReceiver::peek() {
+	return _count ? slot(_head) : NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReceiver::pop() {
+	if (_count) {
+		if (++_head == _capacity) {
+			_head = 0;
+		}
+		--_count;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReceiver::clear() {
+	for (uint8_t i = 0; i < _capacity; ++i) {
+		slot(i)->clear();
+	}
+	_head = 0;
+	_count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimplePacketBase *SimpleCommReceiver::slot(uint8_t index) {
+	return (SimplePacketBase*) ((uint8_t*) _slots + index * _stride);
+}
@@ -0,0 +1,73 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleCommReceiver_H__
+#define __SimpleCommReceiver_H__
+
+#include "SimpleCommLink.h"
+
+
+// Receives packets into a fixed-capacity ring of packet slots, of any
+// capacity (frames too long for them are length errors). Frames are parsed
+// straight into their slot and handed out in place through peek()/pop(),
+// without copies.
+class SimpleCommReceiver {
+public:
+	template <sp_len_t C>
+	explicit SimpleCommReceiver(SimpleCommLink &link, BasicSimplePacket<C> *slots, uint8_t capacity) : _link(link) {
+		init(slots, sizeof(BasicSimplePacket<C>), capacity);
+	}
+
+	// Parses every available byte until the stream is drained or the ring
+	// is full. Returns the number of packets completed by this call.
+	uint8_t poll();
+
+	uint8_t available() const;
+	bool isFull() const;
+
+	// Oldest received packet, or NULL when there is none. It stays valid
+	// until pop() is called.
+	SimplePacketBase *peek();
+	void pop();
+
+	void clear();
+
+private:
+	void init(SimplePacketBase *slots, uint16_t stride, uint8_t capacity);
+	SimplePacketBase *slot(uint8_t index);
+
+private:
+	SimpleCommLink &_link;
+	SimplePacketBase *_slots;
+	uint16_t _stride;
+	uint8_t _capacity;
+	uint8_t _head;
+	uint8_t _count;
+};
+
+// SimpleCommReceiver owning its N slots, of CAPACITY bytes of payload
+template <uint8_t N, sp_len_t CAPACITY = SP_MAX_DATA_LEN>
+class SimpleCommReceiverBuffer : public SimpleCommReceiver {
+public:
+	explicit SimpleCommReceiverBuffer(SimpleCommLink &link) : SimpleCommReceiver(link, _packets, N) {
+	}
+
+private:
+	BasicSimplePacket<CAPACITY> _packets[N];
+};
+
+#endif // __SimpleCommReceiver_H__
@@ -0,0 +1,374 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommReliable.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommReliable::SimpleCommReliable(SimpleCommLink &link, SimpleCommReliableSlot *slots, uint8_t capacity) : _link(link) {
+	// The slots may not be constructed yet (SimpleCommReliableBuffer): don't touch them
+	_slots = slots;
+	_capacity = capacity > MAX_SLOTS ? MAX_SLOTS : capacity;
+	_used = 0;
+	_retries = 3;
+	_evict = 0;
+	_initialTimeout = 1000000UL;
+	_margin = 5000UL;
+	_maxTimeout = 10000000UL;
+	memset(_peers, 0, sizeof(_peers));
+	resetStats();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReliable::send(const SimplePacketBase &packet, uint8_t destination) {
+	for (uint8_t i = 0; i < _capacity; ++i) {
+		if (!(_used & (1UL << i))) {
+			_slots[i].packet = packet;
+			return push(_slots[i], destination);
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReliable::send(const SimplePacketBase &packet, uint8_t destination, uint8_t type) {
+	for (uint8_t i = 0; i < _capacity; ++i) {
+		if (!(_used & (1UL << i))) {
+			_slots[i].packet = packet;
+			_slots[i].packet.setType(type);
+			return push(_slots[i], destination);
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReliable::receive(SimplePacketBase &packet) {
+	while (_link.receive(packet)) {
+		sp_len_t len = packet._dataLen;
+		if (len == 0) {
+			// Not sent in reliable mode
+			continue;
+		}
+
+		// Strip the control byte
+		uint8_t control = packet.buffer()->data[len - 1];
+		packet._dataLen = len - 1;
+#if SP_CRC_MODE == SP_CRC_SUM
+		packet._crc -= control;
+#endif
+
+		uint8_t source = packet.getSource();
+		uint8_t sequence = control & SEQUENCE_MASK;
+		uint8_t kind = control & KIND_MASK;
+		if (kind == ACK) {
+			for (uint8_t i = 0; i < _capacity; ++i) {
+				SimpleCommReliableSlot &slot = _slots[i];
+				if ((_used & (1UL << i)) && slot.destination == source && slot.sequence == sequence) {
+					// Only frames sent once tell the round-trip time
+					Peer *peer = findPeer(source);
+					if (peer && slot.tries == 1) {
+						measure(*peer, _link._clock() - slot.sentAt);
+					}
+					if (peer) {
+						peer->txAcked = true;
+					}
+					_used &= ~(1UL << i);
+					break;
+				}
+			}
+		}
+		else if (kind == NACK) {
+			for (uint8_t i = 0; i < _capacity; ++i) {
+				SimpleCommReliableSlot &slot = _slots[i];
+				if ((_used & (1UL << i)) && slot.destination == source && slot.sequence == sequence) {
+					++_stats.retransmissions;
+					transmit(slot);
+					break;
+				}
+			}
+		}
+		else {
+			if (source == 0 || packet.getDestination() == 0) {
+				// Broadcasts are not acknowledged, nor senders without an address
+				return true;
+			}
+
+			Peer *peer = findPeer(source);
+			if (!peer) {
+				peer = addPeer(source);
+			}
+			bool fresh = !peer || accept(*peer, kind, sequence, packet.getType());
+			reply(source, packet.getType(), ACK | sequence);
+			if (fresh) {
+				return true;
+			}
+			++_stats.duplicates;
+		}
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommReliable::poll() {
+	if (_used == 0) {
+		return 0;
+	}
+
+	unsigned long now = _link._clock();
+	uint8_t dropped = 0;
+	for (uint8_t i = 0; i < _capacity; ++i) {
+		SimpleCommReliableSlot &slot = _slots[i];
+		if (!(_used & (1UL << i)) || now - slot.sentAt < slot.timeout) {
+			continue;
+		}
+
+		if (slot.tries > _retries) {
+			_used &= ~(1UL << i);
+			++_stats.failures;
+			++dropped;
+			continue;
+		}
+
+		// Back off until an ACK measures the round-trip time again
+		slot.timeout = slot.timeout < _maxTimeout / 2 ? slot.timeout * 2 : _maxTimeout;
+		Peer *peer = findPeer(slot.destination);
+		if (peer && peer->rto < slot.timeout) {
+			peer->rto = slot.timeout;
+		}
+		++_stats.retransmissions;
+		transmit(slot);
+	}
+
+	return dropped;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReliable::setRetries(uint8_t retries) {
+	_retries = retries;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReliable::setTimeouts(unsigned long initial, unsigned long margin, unsigned long maximum) {
+	_initialTimeout = initial;
+	_margin = margin;
+	_maxTimeout = maximum;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SimpleCommReliable::getTimeout(uint8_t destination) const {
+	Peer *peer = findPeer(destination);
+	return peer ? peer->rto : _initialTimeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommReliable::pending() const {
+	uint8_t count = 0;
+	for (uint32_t used = _used; used; used &= used - 1) {
+		++count;
+	}
+	return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReliable::isPending(uint8_t destination) const {
+	for (uint8_t i = 0; i < _capacity; ++i) {
+		if ((_used & (1UL << i)) && _slots[i].destination == destination) {
+			return true;
+		}
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReliable::clear() {
+	_used = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleCommReliableStats &SimpleCommReliable::getStats() const {
+	return _stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReliable::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommReliable::Peer *SimpleCommReliable::findPeer(uint8_t address) const {
+	for (uint8_t i = 0; i < SP_RELIABLE_PEERS; ++i) {
+		if (_peers[i].address == address) {
+			return (Peer*) &_peers[i];
+		}
+	}
+	return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommReliable::Peer *SimpleCommReliable::addPeer(uint8_t address) {
+	Peer *peer = findPeer(0);
+	for (uint8_t i = 0; !peer && i < SP_RELIABLE_PEERS; ++i) {
+		// Forget the peers in turn, never one with frames in flight
+		Peer *candidate = &_peers[_evict];
+		if (++_evict == SP_RELIABLE_PEERS) {
+			_evict = 0;
+		}
+		if (!isPending(candidate->address)) {
+			peer = candidate;
+		}
+	}
+	if (!peer) {
+		return NULL;
+	}
+
+	memset(peer, 0, sizeof(Peer));
+	peer->address = address;
+	// Start where a previous run of this sender is unlikely to have stopped
+	peer->txSequence = _link._clock() >> 4;
+	peer->rto = _initialTimeout;
+	return peer;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReliable::measure(Peer &peer, unsigned long rtt) {
+	if (rtt == 0) {
+		rtt = 1;
+	}
+
+	// Smoothed round-trip time and its variation, as TCP does (RFC 6298)
+	if (peer.srtt == 0) {
+		peer.srtt = rtt;
+		peer.rttvar = rtt / 2;
+	}
+	else {
+		unsigned long delta = rtt > peer.srtt ? rtt - peer.srtt : peer.srtt - rtt;
+		peer.rttvar = (3 * peer.rttvar + delta) / 4;
+		peer.srtt = (7 * peer.srtt + rtt) / 8;
+	}
+
+	// The margin covers the jitter a steady round-trip time stops measuring
+	unsigned long margin = 4 * peer.rttvar;
+	if (margin < _margin) {
+		margin = _margin;
+	}
+	unsigned long rto = peer.srtt + margin;
+	if (rto > _maxTimeout) {
+		rto = _maxTimeout;
+	}
+	peer.rto = rto;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReliable::push(SimpleCommReliableSlot &slot, uint8_t destination) {
+	if (destination == 0 || _link.getAddress() == 0) {
+		return false;
+	}
+
+	Peer *peer = findPeer(destination);
+	if (!peer) {
+		peer = addPeer(destination);
+	}
+	if (!peer) {
+		return false;
+	}
+
+	uint8_t control = (peer->txAcked ? DATA : RESET) | (peer->txSequence & SEQUENCE_MASK);
+	if (!slot.packet.addData(&control, 1)) {
+		return false;
+	}
+	++peer->txSequence;
+
+	slot.destination = destination;
+	slot.sequence = control & SEQUENCE_MASK;
+	slot.tries = 0;
+	slot.timeout = peer->rto;
+	_used |= 1UL << (&slot - _slots);
+	transmit(slot);
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReliable::transmit(SimpleCommReliableSlot &slot) {
+	// Frames resent after the first ACK don't reset the receiver again
+	uint8_t &control = slot.packet.buffer()->data[slot.packet._dataLen - 1];
+	if ((control & KIND_MASK) == RESET) {
+		Peer *peer = findPeer(slot.destination);
+		if (peer && peer->txAcked) {
+			control = DATA | (control & SEQUENCE_MASK);
+#if SP_CRC_MODE == SP_CRC_SUM
+			slot.packet._crc -= RESET;
+#endif
+		}
+	}
+
+	slot.sentAt = _link._clock();
+	++slot.tries;
+	_link.send(slot.packet, slot.destination);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommReliable::reply(uint8_t destination, uint8_t type, uint8_t control) {
+	_reply.setData(&control, 1);
+	_link.send(_reply, destination, type);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommReliable::accept(Peer &peer, uint8_t kind, uint8_t sequence, uint8_t type) {
+	// The first RESET frame of a run of the sender forgets the previous run.
+	// The next ones come before any DATA frame, frames being never reordered
+	// on the line, and are tracked as usual.
+	if (kind != RESET) {
+		peer.rxReset = false;
+	}
+	else if (!peer.rxReset) {
+		peer.rxReset = true;
+		peer.rxValid = false;
+	}
+
+	if (!peer.rxValid) {
+		peer.rxValid = true;
+		peer.rxLast = sequence;
+		peer.rxReceived = 1;
+		return true;
+	}
+
+	uint8_t ahead = (sequence - peer.rxLast) & SEQUENCE_MASK;
+	if (ahead == 0) {
+		return false;
+	}
+
+	if (ahead < 32) {
+		// Frames are never reordered on the line: the skipped ones were lost
+		for (uint8_t missing = 1; missing < ahead; ++missing) {
+			reply(peer.address, type, NACK | ((peer.rxLast + missing) & SEQUENCE_MASK));
+			++_stats.nacksSent;
+		}
+		peer.rxReceived = (peer.rxReceived << ahead) | 1;
+		peer.rxLast = sequence;
+		return true;
+	}
+
+	// Late frame, resent after a loss: new unless already received. Older
+	// ones than the tracked 32 are taken as duplicates.
+	uint8_t behind = SEQUENCE_MASK + 1 - ahead;
+	if (behind >= 32 || (peer.rxReceived & (1UL << behind))) {
+		return false;
+	}
+	peer.rxReceived |= 1UL << behind;
+	return true;
+}
@@ -0,0 +1,156 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SimpleCommReliable_H__
+#define __SimpleCommReliable_H__
+
+#include "SimpleCommLink.h"
+
+// Peers whose sequence numbers, round-trip times and received frames are
+// tracked. When they are all in use, one without pending frames is
+// forgotten.
+#ifndef SP_RELIABLE_PEERS
+#define SP_RELIABLE_PEERS 4
+#endif
+
+// Frame waiting for its ACK
+typedef struct {
+	SimplePacket packet;
+	unsigned long sentAt;
+	unsigned long timeout;
+	uint8_t destination;
+	uint8_t sequence;
+	uint8_t tries;
+} SimpleCommReliableSlot;
+
+typedef struct {
+	uint32_t retransmissions;
+	uint32_t failures;
+	uint32_t duplicates;
+	uint32_t nacksSent;
+} SimpleCommReliableStats;
+
+// Acknowledged delivery over a link. Every frame ends with a control byte:
+// its kind (DATA, RESET, ACK or NACK) and a 6-bit sequence number per destination.
+// DATA frames are kept in a fixed table of slots and sent again when their
+// ACK doesn't come within a timeout derived from the measured round-trip
+// time, or right away when the receiver reports them missing with a NACK.
+// Receivers acknowledge every DATA frame and drop the duplicates. Until its
+// first ACK from a destination, a sender sends RESET frames instead, so a
+// receiver that tracked a previous run of the sender starts over. Both ends
+// of the link must use it, with addresses other than 0.
+class SimpleCommReliable {
+public:
+	static const uint8_t DATA = 0x00;
+	static const uint8_t ACK = 0x40;
+	static const uint8_t NACK = 0x80;
+	static const uint8_t RESET = 0xC0;
+	static const uint8_t KIND_MASK = 0xC0;
+	static const uint8_t SEQUENCE_MASK = 0x3F;
+
+	static const uint8_t MAX_SLOTS = 32;
+
+	// Up to MAX_SLOTS slots
+	explicit SimpleCommReliable(SimpleCommLink &link, SimpleCommReliableSlot *slots, uint8_t capacity);
+
+	// Sends a copy of the packet and keeps it until it is acknowledged.
+	// Returns false when every slot is in use, the payload leaves no room
+	// for the control byte, or the destination or the link address is 0.
+	bool send(const SimplePacketBase &packet, uint8_t destination);
+	bool send(const SimplePacketBase &packet, uint8_t destination, uint8_t type);
+
+	// Receives the next new packet, without its control byte. ACKs and
+	// NACKs are consumed, duplicates acknowledged again and dropped.
+	bool receive(SimplePacketBase &packet);
+
+	// Sends again the frames whose timeout expired and gives up those sent
+	// more than retries + 1 times. Returns the number of frames given up.
+	uint8_t poll();
+
+	// Resends before giving up a frame (3 by default)
+	void setRetries(uint8_t retries);
+
+	// Timeouts, in microseconds of the link clock: the one used until a
+	// round-trip time is measured (1 s by default), the least margin added
+	// to the smoothed round-trip time (5 ms), which should cover the period
+	// of the loop calling receive(), and the maximum (10 s)
+	void setTimeouts(unsigned long initial, unsigned long margin = 5000UL, unsigned long maximum = 10000000UL);
+
+	// Current retransmission timeout of a destination
+	unsigned long getTimeout(uint8_t destination) const;
+
+	uint8_t pending() const;
+	bool isPending(uint8_t destination) const;
+
+	// Drops every pending frame
+	void clear();
+
+	const SimpleCommReliableStats &getStats() const;
+	void resetStats();
+
+private:
+	typedef struct {
+		// 0 when the entry is free: broadcasts are never acknowledged
+		uint8_t address;
+		uint8_t txSequence;
+		// An ACK came since the peer was added: DATA frames are sent
+		bool txAcked;
+		uint8_t rxLast;
+		bool rxValid;
+		// rxLast was reset by a RESET frame, and no DATA frame came since
+		bool rxReset;
+		// Frames received up to rxLast, rxLast being bit 0
+		uint32_t rxReceived;
+		unsigned long srtt;
+		unsigned long rttvar;
+		unsigned long rto;
+	} Peer;
+
+	Peer *findPeer(uint8_t address) const;
+	Peer *addPeer(uint8_t address);
+	void measure(Peer &peer, unsigned long rtt);
+	bool push(SimpleCommReliableSlot &slot, uint8_t destination);
+	void transmit(SimpleCommReliableSlot &slot);
+	void reply(uint8_t destination, uint8_t type, uint8_t control);
+	bool accept(Peer &peer, uint8_t kind, uint8_t sequence, uint8_t type);
+
+private:
+	SimpleCommLink &_link;
+	SimpleCommReliableSlot *_slots;
+	uint8_t _capacity;
+	uint32_t _used;
+	uint8_t _retries;
+	uint8_t _evict;
+	unsigned long _initialTimeout;
+	unsigned long _margin;
+	unsigned long _maxTimeout;
+	Peer _peers[SP_RELIABLE_PEERS];
+	SimplePacket _reply;
+	SimpleCommReliableStats _stats;
+};
+
+// SimpleCommReliable owning its N slots
+template <uint8_t N>
+class SimpleCommReliableBuffer : public SimpleCommReliable {
+public:
+	explicit SimpleCommReliableBuffer(SimpleCommLink &link) : SimpleCommReliable(link, _entries, N) {
+	}
+
+private:
+	SimpleCommReliableSlot _entries[N];
+};
+
+#endif // __SimpleCommReliable_H__
@@ -0,0 +1,178 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommRouter.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommRouter::SimpleCommRouter(SimpleCommRouterPort *ports, uint8_t portCapacity,
+		SimpleCommRoute *routes, uint8_t routeCapacity) {
+	// The tables may not be constructed yet (SimpleCommRouterBuffer): don't touch them
+	_ports = ports;
+	_portCapacity = portCapacity;
+	_portCount = 0;
+	_routes = routes;
+	_routeCapacity = routeCapacity;
+	_routeCount = 0;
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommRouter::addPort(SimpleCommLink &link, SimpleCommTxQueue *queue) {
+	if (_portCount == _portCapacity || _portCount == NONE) {
+		return NONE;
+	}
+
+	SimpleCommRouterPort &port = _ports[_portCount];
+	port.link = &link;
+	port.queue = queue;
+	port.packet.clear();
+	return _portCount++;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommRouter::addRoute(uint8_t address, uint8_t port, uint8_t mask) {
+	if (_routeCount == _routeCapacity || port >= _portCount) {
+		return false;
+	}
+
+	SimpleCommRoute &route = _routes[_routeCount++];
+	route.address = address & mask;
+	route.mask = mask;
+	route.port = port;
+	route.packets = 0;
+	route.bytes = 0;
+	route.drops = 0;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommRouter::clearRoutes() {
+	_routeCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommRouter::poll() {
+	uint32_t before = _stats.forwarded + _stats.broadcasts;
+
+	for (uint8_t i = 0; i < _portCount; ++i) {
+		// Bounded, so a flooded port can't starve the others
+		for (uint8_t count = 0; count < 0xFF && _ports[i].link->receive(_ports[i].packet); ++count) {
+			route(i);
+		}
+	}
+
+	for (uint8_t i = 0; i < _portCount; ++i) {
+		if (_ports[i].queue) {
+			_ports[i].queue->poll();
+		}
+	}
+
+	uint32_t forwarded = _stats.forwarded + _stats.broadcasts - before;
+	return forwarded > 0xFF ? 0xFF : forwarded;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommRouter::routeCount() const {
+	return _routeCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleCommRoute *SimpleCommRouter::getRoute(uint8_t index) const {
+	return index < _routeCount ? &_routes[index] : NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleCommRouterStats &SimpleCommRouter::getStats() const {
+	return _stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommRouter::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+	for (uint8_t i = 0; i < _routeCount; ++i) {
+		_routes[i].packets = 0;
+		_routes[i].bytes = 0;
+		_routes[i].drops = 0;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommRouter::route(uint8_t from) {
+	SimplePacket &packet = _ports[from].packet;
+	uint8_t destination = packet.getDestination();
+
+	if (destination == 0) {
+		// Broadcasts go everywhere but back
+		bool sent = false;
+		for (uint8_t i = 0; i < _portCount; ++i) {
+			if (i != from) {
+				if (output(i, packet)) {
+					sent = true;
+				}
+				else {
+					++_stats.drops;
+				}
+			}
+		}
+		if (sent) {
+			++_stats.broadcasts;
+		}
+		return;
+	}
+
+	for (uint8_t i = 0; i < _routeCount; ++i) {
+		SimpleCommRoute &route = _routes[i];
+		if (((destination ^ route.address) & route.mask) != 0) {
+			continue;
+		}
+
+		if (route.port == from) {
+			// The destination is on the bus the frame came from
+			break;
+		}
+		if (output(route.port, packet)) {
+			++route.packets;
+			route.bytes += packet.getDataLength();
+			++_stats.forwarded;
+		}
+		else {
+			++route.drops;
+			++_stats.drops;
+		}
+		return;
+	}
+
+	++_stats.unroutable;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommRouter::output(uint8_t port, SimplePacketBase &packet) {
+	SimpleCommRouterPort &to = _ports[port];
+	if (to.queue) {
+		return to.queue->forward(packet);
+	}
+
+	uint8_t scratch[SP_FRAME_SCRATCH_LEN];
+	const uint8_t *frame;
+	sp_len_t length = to.link->relay(packet, scratch, frame);
+	if (to.link->getStream().write(frame, length) != length) {
+		return false;
+	}
+	SP_STAT(++to.link->_stats.packetsSent);
+	SP_STAT(to.link->_stats.bytesSent += length);
+	return true;
+}
@@ -0,0 +1,110 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SimpleCommRouter_H__
+#define __SimpleCommRouter_H__
+
+#include "SimpleCommTxQueue.h"
+
+// Port of a SimpleCommRouter
+typedef struct {
+	SimpleCommLink *link;
+	// Frames leaving by this port are queued here, or written right away
+	// when there is no queue
+	SimpleCommTxQueue *queue;
+	// Frames arriving by this port, kept between polls as it may hold a
+	// partial frame
+	SimplePacket packet;
+} SimpleCommRouterPort;
+
+// Destinations matching address in the bits of mask leave by port
+typedef struct {
+	uint8_t address;
+	uint8_t mask;
+	uint8_t port;
+	uint32_t packets;
+	// Payload bytes
+	uint32_t bytes;
+	// Frames that the port couldn't take (queue full or short write)
+	uint32_t drops;
+} SimpleCommRoute;
+
+typedef struct {
+	uint32_t forwarded;
+	uint32_t broadcasts;
+	// Frames without a route, or routed back to the port they came from
+	uint32_t unroutable;
+	uint32_t drops;
+} SimpleCommRouterStats;
+
+// Forwards frames between several links, e.g. an RS-485 field bus and TCP
+// clients, by destination address. Frames are checked when received and
+// forwarded as they arrived, source included, without being encoded
+// again (except compressed ones, which receive() decodes in place).
+// Broadcasts go to every other port. The links must have address 0, so
+// they receive every frame.
+class SimpleCommRouter {
+public:
+	static const uint8_t NONE = 0xFF;
+
+	explicit SimpleCommRouter(SimpleCommRouterPort *ports, uint8_t portCapacity,
+			SimpleCommRoute *routes, uint8_t routeCapacity);
+
+	// Returns the number of the port, or NONE when there is no room left
+	uint8_t addPort(SimpleCommLink &link, SimpleCommTxQueue *queue = NULL);
+
+	// Routes are tried in the order they were added, so the more specific
+	// ones go first. A mask of 0 makes a default route. Returns false when
+	// the table is full or the port doesn't exist.
+	bool addRoute(uint8_t address, uint8_t port, uint8_t mask = 0xFF);
+	void clearRoutes();
+
+	// Receives from every port, forwards what arrived and writes the
+	// queued frames. Returns the number of frames forwarded.
+	uint8_t poll();
+
+	uint8_t routeCount() const;
+	const SimpleCommRoute *getRoute(uint8_t index) const;
+	const SimpleCommRouterStats &getStats() const;
+	void resetStats();
+
+private:
+	void route(uint8_t from);
+	bool output(uint8_t port, SimplePacketBase &packet);
+
+private:
+	SimpleCommRouterPort *_ports;
+	uint8_t _portCapacity;
+	uint8_t _portCount;
+	SimpleCommRoute *_routes;
+	uint8_t _routeCapacity;
+	uint8_t _routeCount;
+	SimpleCommRouterStats _stats;
+};
+
+// SimpleCommRouter owning room for P ports and R routes
+template <uint8_t P, uint8_t R>
+class SimpleCommRouterBuffer : public SimpleCommRouter {
+public:
+	explicit SimpleCommRouterBuffer() : SimpleCommRouter(_portTable, P, _routeTable, R) {
+	}
+
+private:
+	SimpleCommRouterPort _portTable[P];
+	SimpleCommRoute _routeTable[R];
+};
+
+#endif // __SimpleCommRouter_H__
@@ -0,0 +1,207 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommScheduler.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommScheduler::SimpleCommScheduler(SimpleCommLink &link, SimpleCommSchedulerSlave *slaves, uint8_t capacity,
+		SimpleCommRequestHandler request, SimpleCommReplyHandler reply) : _link(link) {
+	_slaves = slaves;
+	_capacity = capacity;
+	_count = 0;
+	_requestHandler = request;
+	_replyHandler = reply;
+	_current = NONE;
+	_sentAt = 0;
+	_wait = 0;
+	_timeout = 100000UL;
+	_margin = 2000UL;
+	_offlineMisses = 3;
+	_offlinePeriod = 5000000UL;
+	resetStats();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommScheduler::add(uint8_t address, unsigned long period, uint8_t priority) {
+	if (_count == _capacity || find(address)) {
+		return false;
+	}
+
+	SimpleCommSchedulerSlave &slave = _slaves[_count++];
+	slave.period = period;
+	slave.nextDue = _link._clock();
+	slave.response = 0;
+	slave.address = address;
+	slave.priority = priority;
+	slave.misses = 0;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommScheduler::remove(uint8_t address) {
+	SimpleCommSchedulerSlave *slave = find(address);
+	if (!slave) {
+		return false;
+	}
+
+	uint8_t index = slave - _slaves;
+	if (_current == index) {
+		// Its reply will be counted as late
+		_current = NONE;
+	}
+	else if (_current != NONE && _current > index) {
+		--_current;
+	}
+	--_count;
+	for (uint8_t i = index; i < _count; ++i) {
+		_slaves[i] = _slaves[i + 1];
+	}
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommScheduler::count() const {
+	return _count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommScheduler::poll() {
+	while (_link.receive(_reply)) {
+		if (_current != NONE && _reply.getSource() == _slaves[_current].address) {
+			complete(_link._clock(), &_reply);
+		}
+		else {
+			++_stats.lateReplies;
+		}
+	}
+
+	unsigned long now = _link._clock();
+	if (_current != NONE && now - _sentAt >= _wait) {
+		complete(now, NULL);
+	}
+	if (_current == NONE) {
+		next(now);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommScheduler::setTimeout(unsigned long timeout, unsigned long margin) {
+	_timeout = timeout;
+	_margin = margin;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommScheduler::setOffline(uint8_t misses, unsigned long period) {
+	_offlineMisses = misses;
+	_offlinePeriod = period;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommScheduler::isOnline(uint8_t address) const {
+	SimpleCommSchedulerSlave *slave = find(address);
+	return slave && slave->misses < _offlineMisses;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+float SimpleCommScheduler::getUtilisation() const {
+	unsigned long elapsed = _link._clock() - _statsSince;
+	return elapsed ? (float) _stats.busyTime / elapsed : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const SimpleCommSchedulerStats &SimpleCommScheduler::getStats() const {
+	return _stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommScheduler::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+	_statsSince = _link._clock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimpleCommSchedulerSlave *SimpleCommScheduler::find(uint8_t address) const {
+	for (uint8_t i = 0; i < _count; ++i) {
+		if (_slaves[i].address == address) {
+			return &_slaves[i];
+		}
+	}
+	return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommScheduler::complete(unsigned long now, const SimplePacket *reply) {
+	SimpleCommSchedulerSlave &slave = _slaves[_current];
+	unsigned long elapsed = now - _sentAt;
+	_stats.busyTime += elapsed;
+	_current = NONE;
+
+	if (reply) {
+		++_stats.replies;
+		slave.response = slave.response ? (7 * slave.response + elapsed) / 8 : elapsed;
+		slave.misses = 0;
+	}
+	else {
+		++_stats.timeouts;
+		_stats.timeoutTime += elapsed;
+		if (slave.misses < 0xFF) {
+			++slave.misses;
+		}
+	}
+
+	// Keep the pace of the period, without bursts to catch up
+	unsigned long period = slave.misses >= _offlineMisses ? _offlinePeriod : slave.period;
+	slave.nextDue += period;
+	if ((long) (now - slave.nextDue) > 0) {
+		slave.nextDue = now;
+	}
+
+	_replyHandler(slave.address, reply);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommScheduler::next(unsigned long now) {
+	SimpleCommSchedulerSlave *best = NULL;
+	for (uint8_t i = 0; i < _count; ++i) {
+		SimpleCommSchedulerSlave &slave = _slaves[i];
+		if ((long) (now - slave.nextDue) < 0) {
+			continue;
+		}
+		if (!best || slave.priority > best->priority
+		    || (slave.priority == best->priority && (long) (slave.nextDue - best->nextDue) < 0)) {
+			best = &slave;
+		}
+	}
+	if (!best) {
+		return;
+	}
+
+	_request.clear();
+	if (!_requestHandler(best->address, _request)) {
+		best->nextDue = now + best->period;
+		return;
+	}
+
+	_link.send(_request, best->address);
+	++_stats.requests;
+	_current = best - _slaves;
+	_sentAt = now;
+	_wait = _timeout;
+	if (best->response && 2 * best->response + _margin < _timeout) {
+		_wait = 2 * best->response + _margin;
+	}
+}
@@ -0,0 +1,129 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __SimpleCommScheduler_H__
+#define __SimpleCommScheduler_H__
+
+#include "SimpleCommLink.h"
+
+// Fills the request sent to a slave. Returning false skips it this time.
+typedef bool (*SimpleCommRequestHandler)(uint8_t address, SimplePacket &request);
+
+// Called with the reply of a slave, or with NULL when it didn't answer in time
+typedef void (*SimpleCommReplyHandler)(uint8_t address, const SimplePacket *reply);
+
+// Slave polled by a SimpleCommScheduler
+typedef struct {
+	unsigned long period;
+	unsigned long nextDue;
+	// Smoothed time from request to reply, 0 until the first reply
+	unsigned long response;
+	uint8_t address;
+	uint8_t priority;
+	// Requests in a row without reply
+	uint8_t misses;
+} SimpleCommSchedulerSlave;
+
+typedef struct {
+	uint32_t requests;
+	uint32_t replies;
+	uint32_t timeouts;
+	uint32_t lateReplies;
+	// Time spent waiting for replies, and the part of it for those that
+	// never came, in microseconds
+	unsigned long busyTime;
+	unsigned long timeoutTime;
+} SimpleCommSchedulerStats;
+
+// Master side of a polled bus (RS-485): one request on the bus at a time,
+// the next one sent as soon as the reply, or the timeout, of the previous
+// one arrives. Among the slaves due, the highest priority goes first, then
+// the one waiting for longer. The timeout of a slave follows its response
+// time, and slaves that stopped answering are only polled now and then, so
+// the poll cycle follows the actual response times.
+class SimpleCommScheduler {
+public:
+	static const uint8_t NONE = 0xFF;
+
+	explicit SimpleCommScheduler(SimpleCommLink &link, SimpleCommSchedulerSlave *slaves, uint8_t capacity,
+			SimpleCommRequestHandler request, SimpleCommReplyHandler reply);
+
+	// Polls a slave every period microseconds of the link clock (0: as
+	// often as the bus allows). Higher priorities are always served first,
+	// so their periods must leave room for the others. Returns false when
+	// the table is full or the slave is already in it.
+	bool add(uint8_t address, unsigned long period, uint8_t priority = 0);
+	bool remove(uint8_t address);
+	uint8_t count() const;
+
+	// Receives the replies, handles the timeouts and sends the next request
+	// when the bus is free. It is meant to be called from the loop, as
+	// often as possible.
+	void poll();
+
+	// Longest wait for a reply (100 ms by default). Slaves that answered
+	// before wait for twice their response time plus margin (2 ms).
+	void setTimeout(unsigned long timeout, unsigned long margin = 2000UL);
+
+	// Slaves missing this many replies in a row (3 by default) are polled
+	// every period (5 s by default) until they answer again
+	void setOffline(uint8_t misses, unsigned long period);
+	bool isOnline(uint8_t address) const;
+
+	// Share of the time since resetStats() spent waiting for replies, 0 to 1
+	float getUtilisation() const;
+
+	const SimpleCommSchedulerStats &getStats() const;
+	void resetStats();
+
+private:
+	SimpleCommSchedulerSlave *find(uint8_t address) const;
+	void complete(unsigned long now, const SimplePacket *reply);
+	void next(unsigned long now);
+
+private:
+	SimpleCommLink &_link;
+	SimpleCommSchedulerSlave *_slaves;
+	uint8_t _capacity;
+	uint8_t _count;
+	SimpleCommRequestHandler _requestHandler;
+	SimpleCommReplyHandler _replyHandler;
+	SimplePacket _request;
+	SimplePacket _reply;
+	uint8_t _current;
+	unsigned long _sentAt;
+	unsigned long _wait;
+	unsigned long _timeout;
+	unsigned long _margin;
+	uint8_t _offlineMisses;
+	unsigned long _offlinePeriod;
+	unsigned long _statsSince;
+	SimpleCommSchedulerStats _stats;
+};
+
+// SimpleCommScheduler owning a table of N slaves
+template <uint8_t N>
+class SimpleCommSchedulerBuffer : public SimpleCommScheduler {
+public:
+	explicit SimpleCommSchedulerBuffer(SimpleCommLink &link, SimpleCommRequestHandler request, SimpleCommReplyHandler reply) :
+			SimpleCommScheduler(link, _entries, N, request, reply) {
+	}
+
+private:
+	SimpleCommSchedulerSlave _entries[N];
+};
+
+#endif // __SimpleCommScheduler_H__
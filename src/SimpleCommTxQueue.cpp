@@ -0,0 +1,179 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleCommTxQueue.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommTxQueue::init(SimplePacketBase *slots, uint16_t stride, uint8_t capacity) {
+	// The slots may not be constructed yet (SimpleCommTxQueueBuffer): don't touch them
+	_slots = slots;
+	_stride = stride;
+	_capacity = capacity;
+	_head = 0;
+	_count = 0;
+	_offset = 0;
+	_writeLimit = SP_WRITE_LIMIT;
+	_reportsRoom = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommTxQueue::send(const SimplePacketBase &packet, uint8_t destination) {
+	SimplePacketBase *slot = tail();
+	if (!slot || !slot->copyFrom(packet)) {
+		return false;
+	}
+
+	return push(*slot, destination);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommTxQueue::send(const SimplePacketBase &packet, uint8_t destination, uint8_t type) {
+	SimplePacketBase *slot = tail();
+	if (!slot || !slot->copyFrom(packet)) {
+		return false;
+	}
+
+	slot->setType(type);
+	return push(*slot, destination);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommTxQueue::forward(const SimplePacketBase &packet) {
+	SimplePacketBase *slot = tail();
+	if (!slot || !slot->copyFrom(packet)) {
+		return false;
+	}
+
+	uint8_t scratch[SP_FRAME_SCRATCH_LEN];
+	const uint8_t *frame;
+	sp_len_t frameLen = _link.relay(*slot, scratch, frame);
+	return store(*slot, scratch, frame, frameLen);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommTxQueue::poll() {
+	if (_count == 0) {
+		return 0;
+	}
+
+	Stream &stream = _link.getStream();
+	int room = stream.availableForWrite();
+	if (room > 0) {
+		_reportsRoom = true;
+	}
+	else if (!_reportsRoom) {
+		room = _writeLimit;
+	}
+
+	uint8_t sent = 0;
+	while (_count && room > 0) {
+		sp_len_t frameLen;
+		const uint8_t *frame = SimpleCommLink::encoded(*slot(_head), frameLen);
+		sp_len_t wanted = frameLen - _offset;
+		if (wanted > room) {
+			wanted = room;
+		}
+
+		size_t written = stream.write(frame + _offset, wanted);
+		SP_STAT(_link._stats.bytesSent += written);
+		room -= written;
+		_offset += written;
+		if (_offset < frameLen) {
+			// The rest of the frame goes on the next call
+			break;
+		}
+
+		SP_STAT(++_link._stats.packetsSent);
+		++sent;
+		_offset = 0;
+		if (++_head == _capacity) {
+			_head = 0;
+		}
+		--_count;
+	}
+
+	return sent;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommTxQueue::setWriteLimit(uint8_t limit) {
+	_writeLimit = limit;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleCommTxQueue::pending() const {
+	return _count;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommTxQueue::isEmpty() const {
+	return _count == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommTxQueue::isFull() const {
+	return _count == _capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimpleCommTxQueue::clear() {
+	_head = 0;
+	_count = 0;
+	_offset = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimplePacketBase *SimpleCommTxQueue::slot(uint8_t index) {
+	return (SimplePacketBase*) ((uint8_t*) _slots + index * _stride);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimplePacketBase *SimpleCommTxQueue::tail() {
+	if (_count == _capacity) {
+		return NULL;
+	}
+
+	uint8_t tail = _head + _count;
+	if (tail >= _capacity) {
+		tail -= _capacity;
+	}
+	return slot(tail);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommTxQueue::push(SimplePacketBase &slot, uint8_t destination) {
+	uint8_t scratch[SP_FRAME_SCRATCH_LEN];
+	const uint8_t *frame;
+	sp_len_t frameLen = _link.encode(slot, destination, scratch, frame);
+	return store(slot, scratch, frame, frameLen);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimpleCommTxQueue::store(SimplePacketBase &slot, const uint8_t *scratch, const uint8_t *frame, sp_len_t frameLen) {
+	if (frameLen == 0) {
+		return false;
+	}
+	const uint8_t *buffer = (const uint8_t*) slot.buffer();
+	if (frame < buffer || frame >= buffer + slot.bufferSize()) {
+		// Compressed frames are built apart, with the layout of a packet
+		// buffer: the slot only has to hold them
+		memcpy(slot.buffer(), scratch, frame - scratch + frameLen);
+	}
+
+	++_count;
+	return true;
+}
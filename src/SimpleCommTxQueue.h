@@ -0,0 +1,90 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleCommTxQueue_H__
+#define __SimpleCommTxQueue_H__
+
+#include "SimpleCommLink.h"
+
+
+// Sends packets without blocking: frames are encoded into a fixed-capacity
+// ring of packet slots, of any capacity, and written by poll(), never more
+// bytes than the stream can take at once (availableForWrite()).
+class SimpleCommTxQueue {
+public:
+	template <sp_len_t C>
+	explicit SimpleCommTxQueue(SimpleCommLink &link, BasicSimplePacket<C> *slots, uint8_t capacity) : _link(link) {
+		init(slots, sizeof(BasicSimplePacket<C>), capacity);
+	}
+
+	// Queues a copy of the packet. Returns false when the queue is full or
+	// the packet is too long, for the link or for the slots.
+	bool send(const SimplePacketBase &packet, uint8_t destination = 0);
+	bool send(const SimplePacketBase &packet, uint8_t destination, uint8_t type);
+
+	// Queues a copy of a received packet as it arrived, source included.
+	// Its frame is not encoded again unless it was compressed.
+	bool forward(const SimplePacketBase &packet);
+
+	// Writes the pending bytes the stream can take without blocking.
+	// Returns the number of frames completely written by this call.
+	uint8_t poll();
+
+	// Streams that don't implement availableForWrite() report 0, as full
+	// ones do. Until the stream reports room, poll() writes up to limit
+	// bytes per call instead (SP_WRITE_LIMIT by default, 0 waits for room).
+	void setWriteLimit(uint8_t limit);
+
+	uint8_t pending() const;
+	bool isEmpty() const;
+	bool isFull() const;
+
+	// Drops every pending frame, including a partially written one
+	void clear();
+
+private:
+	void init(SimplePacketBase *slots, uint16_t stride, uint8_t capacity);
+	SimplePacketBase *slot(uint8_t index);
+	SimplePacketBase *tail();
+	bool push(SimplePacketBase &slot, uint8_t destination);
+	bool store(SimplePacketBase &slot, const uint8_t *scratch, const uint8_t *frame, sp_len_t frameLen);
+
+private:
+	SimpleCommLink &_link;
+	SimplePacketBase *_slots;
+	uint16_t _stride;
+	uint8_t _capacity;
+	uint8_t _head;
+	uint8_t _count;
+	sp_len_t _offset;
+	uint8_t _writeLimit;
+	// The stream implements availableForWrite()
+	bool _reportsRoom;
+};
+
+// SimpleCommTxQueue owning its N slots, of CAPACITY bytes of payload
+template <uint8_t N, sp_len_t CAPACITY = SP_MAX_DATA_LEN>
+class SimpleCommTxQueueBuffer : public SimpleCommTxQueue {
+public:
+	explicit SimpleCommTxQueueBuffer(SimpleCommLink &link) : SimpleCommTxQueue(link, _packets, N) {
+	}
+
+private:
+	BasicSimplePacket<CAPACITY> _packets[N];
+};
+
+#endif // __SimpleCommTxQueue_H__
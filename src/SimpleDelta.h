@@ -0,0 +1,71 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleDelta_H__
+#define __SimpleDelta_H__
+
+#include "SimplePacketReader.h"
+
+
+// Delta encoding of N fields against their last sent values: each field
+// goes on the wire as the varint of its difference, so counters and slowly
+// changing values take one byte. The sender keeps one SimpleDelta per
+// destination and the receiver one per source, both updated packet after
+// packet.
+//
+// A lost packet leaves the receiver with wrong values: send the absolute
+// values from time to time, e.g. calling reset() on both ends when a
+// packet of another type is sent, or use it on acknowledged links only.
+template <uint8_t N>
+class SimpleDelta {
+public:
+	explicit SimpleDelta() {
+		reset();
+	}
+
+	void reset() {
+		memset(_last, 0, sizeof(_last));
+	}
+
+	// Appends the difference against the last value of the field
+	bool add(SimplePacketBase &packet, uint8_t field, int32_t value) {
+		if (!packet.addVarInt((int32_t) ((uint32_t) value - (uint32_t) _last[field]))) {
+			return false;
+		}
+		_last[field] = value;
+		return true;
+	}
+
+	// Reads a difference and applies it to the last value of the field
+	bool read(SimplePacketReader &reader, uint8_t field, int32_t &value) {
+		uint32_t delta;
+		if (!reader.readVarUInt(delta)) {
+			return false;
+		}
+		value = _last[field] = (int32_t) ((uint32_t) _last[field] + (uint32_t) SimpleWire::unzigzag(delta));
+		return true;
+	}
+
+	int32_t get(uint8_t field) const {
+		return _last[field];
+	}
+
+private:
+	int32_t _last[N];
+};
+
+#endif // __SimpleDelta_H__
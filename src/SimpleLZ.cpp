@@ -0,0 +1,128 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleLZ.h"
+
+#define HASH_SIZE (1 << SP_LZ_HASH_BITS)
+#define NO_POS 0xFFFF
+
+static inline uint8_t hash(const uint8_t *in) {
+	uint32_t value = in[0] | ((uint32_t) in[1] << 8) | ((uint32_t) in[2] << 16);
+	return (uint32_t) (value * 2654435761UL) >> (32 - SP_LZ_HASH_BITS);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint16_t SimpleLZ::compress(const uint8_t *in, uint16_t len, uint8_t *out, uint16_t maxLen) {
+	uint16_t head[HASH_SIZE];
+	for (uint16_t i = 0; i < HASH_SIZE; ++i) {
+		head[i] = NO_POS;
+	}
+
+	uint16_t outLen = 0;
+	uint16_t flagsPos = 0;
+	uint8_t item = 8;
+	uint16_t pos = 0;
+	while (pos < len) {
+		if (item == 8) {
+			// New group of items
+			if (outLen >= maxLen) {
+				return 0;
+			}
+			flagsPos = outLen++;
+			out[flagsPos] = 0;
+			item = 0;
+		}
+
+		// Longest match at the last position with the same hash
+		uint8_t matchLen = 0;
+		uint16_t matchPos = 0;
+		if (len - pos >= MIN_MATCH) {
+			uint8_t h = hash(in + pos);
+			uint16_t candidate = head[h];
+			head[h] = pos;
+			if (candidate != NO_POS && pos - candidate <= WINDOW) {
+				uint16_t limit = len - pos < MAX_MATCH ? len - pos : MAX_MATCH;
+				while (matchLen < limit && in[candidate + matchLen] == in[pos + matchLen]) {
+					++matchLen;
+				}
+				matchPos = candidate;
+			}
+		}
+
+		if (matchLen >= MIN_MATCH) {
+			if (outLen + 2 > maxLen) {
+				return 0;
+			}
+			uint16_t offset = pos - matchPos - 1;
+			out[outLen++] = offset & 0xFF;
+			out[outLen++] = ((offset >> 8) << 4) | (matchLen - MIN_MATCH);
+			out[flagsPos] |= 1 << item;
+
+			// Positions inside the match feed the hash table too
+			for (uint16_t end = pos + matchLen, p = pos + 1; p < end && len - p >= MIN_MATCH; ++p) {
+				head[hash(in + p)] = p;
+			}
+			pos += matchLen;
+		}
+		else {
+			if (outLen >= maxLen) {
+				return 0;
+			}
+			out[outLen++] = in[pos++];
+		}
+		++item;
+	}
+
+	return outLen;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint16_t SimpleLZ::decompress(const uint8_t *in, uint16_t len, uint8_t *out, uint16_t maxLen) {
+	uint16_t inPos = 0;
+	uint16_t outLen = 0;
+	while (inPos < len) {
+		uint8_t flags = in[inPos++];
+		for (uint8_t item = 0; item < 8 && inPos < len; ++item) {
+			if (flags & (1 << item)) {
+				if (inPos + 2 > len) {
+					return 0;
+				}
+				uint16_t offset = (in[inPos] | ((in[inPos + 1] >> 4) << 8)) + 1;
+				uint8_t matchLen = (in[inPos + 1] & 0x0F) + MIN_MATCH;
+				inPos += 2;
+				if (offset > outLen || outLen + matchLen > maxLen) {
+					return 0;
+				}
+
+				// Byte by byte: the match may overlap what it produces
+				const uint8_t *from = out + outLen - offset;
+				for (uint8_t i = 0; i < matchLen; ++i) {
+					out[outLen + i] = from[i];
+				}
+				outLen += matchLen;
+			}
+			else {
+				if (outLen >= maxLen) {
+					return 0;
+				}
+				out[outLen++] = in[inPos++];
+			}
+		}
+	}
+
+	return outLen;
+}
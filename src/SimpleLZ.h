@@ -0,0 +1,48 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleLZ_H__
+#define __SimpleLZ_H__
+
+#include "SimplePacketConfig.h"
+
+// Bits of the match finder hash table (1 to 8), kept on the stack while
+// compressing: 2 bytes per entry
+#ifndef SP_LZ_HASH_BITS
+#define SP_LZ_HASH_BITS 6
+#endif
+
+
+// Allocation-free LZSS compressor for payloads. A flags byte precedes
+// every group of up to 8 items, its bits (lowest first) telling literals
+// (0, one byte) from matches (1, two bytes: a 12-bit offset minus one and
+// a 4-bit length minus three, i.e. up to 18 bytes from up to 4096 back).
+class SimpleLZ {
+public:
+	static const uint8_t MIN_MATCH = 3;
+	static const uint8_t MAX_MATCH = 18;
+	static const uint16_t WINDOW = 4096;
+
+	// Returns the compressed length, or 0 if it would exceed maxLen
+	static uint16_t compress(const uint8_t *in, uint16_t len, uint8_t *out, uint16_t maxLen);
+
+	// Returns the decompressed length, or 0 if the input is invalid or
+	// would exceed maxLen
+	static uint16_t decompress(const uint8_t *in, uint16_t len, uint8_t *out, uint16_t maxLen);
+};
+
+#endif // __SimpleLZ_H__
@@ -0,0 +1,104 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleMessage_H__
+#define __SimpleMessage_H__
+
+#include "SimplePacket.h"
+
+
+// Size of a list of fields
+template <typename... Fields>
+struct SimpleMessageSize;
+
+template <>
+struct SimpleMessageSize<> {
+	static const size_t value = 0;
+};
+
+template <typename T, typename... Rest>
+struct SimpleMessageSize<T, Rest...> {
+	static const size_t value = SimpleWire::Stored<T>::size + SimpleMessageSize<Rest...>::value;
+};
+
+// Fixed layout payload made of the given fields, packed back to back in
+// the declared order (and encoded as SimpleWire::store() does):
+//
+//   typedef SimpleMessage<int16_t, uint16_t, uint32_t> Reading;
+//
+//   Reading::write(packet, temperature, humidity, timestamp);
+//   ...
+//   if (Reading::read(packet, temperature, humidity, timestamp)) { ... }
+//
+// Offsets and size are resolved at compile time: write() and read() check
+// the length of the payload once, not for every field.
+template <typename... Fields>
+class SimpleMessage {
+public:
+	static_assert(SimpleMessageSize<Fields...>::value <= SP_MAX_DATA_LEN, "Message bigger than SP_MAX_DATA_LEN");
+
+	static const sp_len_t SIZE = SimpleMessageSize<Fields...>::value;
+
+	// Sets the payload of the packet, which must be able to hold it
+	template <sp_len_t N>
+	static void write(BasicSimplePacket<N> &packet, const Fields &... values) {
+		static_assert(SIZE <= N, "Message bigger than the packet");
+
+		put<0>(packet.buffer()->data, values...);
+		packet._dataLen = SIZE;
+#if SP_CRC_MODE == SP_CRC_SUM
+		packet._crc = SimpleCRC::sum(0, packet.buffer()->data, SIZE);
+#endif
+	}
+
+	// Reads the payload of the packet. Returns false, without touching the
+	// values, when its length isn't the size of the message.
+	static bool read(const SimplePacketBase &packet, Fields &... values) {
+		if (packet._dataLen != SIZE) {
+			return false;
+		}
+
+		get<0>(packet.buffer()->data, values...);
+		return true;
+	}
+
+private:
+	template <size_t OFFSET>
+	static void put(uint8_t *) {
+	}
+
+	template <size_t OFFSET, typename T, typename... Rest>
+	static void put(uint8_t *buffer, const T &value, const Rest &... rest) {
+		SimpleWire::store(buffer + OFFSET, value);
+		put<OFFSET + SimpleWire::Stored<T>::size>(buffer, rest...);
+	}
+
+	template <size_t OFFSET>
+	static void get(const uint8_t *) {
+	}
+
+	template <size_t OFFSET, typename T, typename... Rest>
+	static void get(const uint8_t *buffer, T &value, Rest &... rest) {
+		SimpleWire::load(buffer + OFFSET, value);
+		get<OFFSET + SimpleWire::Stored<T>::size>(buffer, rest...);
+	}
+};
+
+template <typename... Fields>
+const sp_len_t SimpleMessage<Fields...>::SIZE;
+
+#endif // __SimpleMessage_H__
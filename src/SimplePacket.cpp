@@ -18,79 +18,95 @@
 #include "SimplePacket.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-SimplePacket::SimplePacket() {
+SimplePacketBase::SimplePacketBase(sp_len_t capacity) {
 	_dataLen = 0;
+	_capacity = capacity;
+	_crc = SP_CRC_INIT;
 	_exhausted = false;
-	memset(&_buff, 0, sizeof(_buff));
+	_buffer = NULL;
 }
 
-void SimplePacket::clear() {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimplePacketBase::attach(uint8_t *storage) {
+	_buffer = storage;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimplePacketBase::clear() {
 	_dataLen = 0;
 	_exhausted = false;
+	_crc = SP_CRC_INIT;
 }
 
 
 #if !defined(UNIVERSAL_CPP) && !defined(CUSTOM_TYPES)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(SP_BOOL data) {
+bool SimplePacketBase::setData(SP_BOOL data) {
 	return setData((unsigned char) data ? 0x01 : 0x00);
 }
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(SP_CHAR data) {
-	return setData(&data, sizeof(data));
+bool SimplePacketBase::setData(SP_CHAR data) {
+	clear();
+	return addData(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(SP_UCHAR data) {
-	return setData(&data, sizeof(data));
+bool SimplePacketBase::setData(SP_UCHAR data) {
+	clear();
+	return addData(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(SP_INT data) {
-	return setData(&data, sizeof(data));
+bool SimplePacketBase::setData(SP_INT data) {
+	clear();
+	return addData(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(SP_UINT data) {
-	return setData(&data, sizeof(data));
+bool SimplePacketBase::setData(SP_UINT data) {
+	clear();
+	return addData(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(SP_LONG data) {
-	return setData(&data, sizeof(data));
+bool SimplePacketBase::setData(SP_LONG data) {
+	clear();
+	return addData(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(SP_ULONG data) {
-	return setData(&data, sizeof(data));
+bool SimplePacketBase::setData(SP_ULONG data) {
+	clear();
+	return addData(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(SP_DOUBLE data) {
-	return setData(&data, sizeof(data));
+bool SimplePacketBase::setData(SP_DOUBLE data) {
+	clear();
+	return addData(data);
 }
 
 #ifdef SP_STRING_TYPE
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(const String &data) {
+bool SimplePacketBase::setData(const String &data) {
 	return setData(data.c_str(), data.length() + 1);
 }
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(const char *data) {
+bool SimplePacketBase::setData(const char *data) {
 	return setData(data, strlen(data) + 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(const __FlashStringHelper* data) {
-	return setData(data, SP_MAX_DATA_LEN);
+bool SimplePacketBase::setData(const __FlashStringHelper* data) {
+	return setData(data, _capacity);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(const __FlashStringHelper* data, uint8_t expectedLength) {
+bool SimplePacketBase::setData(const __FlashStringHelper* data, sp_len_t expectedLength) {
 	char buffer[expectedLength + 1];
 	strncpy_P(buffer, (const char*) data, expectedLength);
 	buffer[expectedLength] = '\0';
@@ -98,7 +114,7 @@ bool SimplePacket::setData(const __FlashStringHelper* data, uint8_t expectedLeng
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::setData(const void *data, uint8_t len) {
+bool SimplePacketBase::setData(const void *data, sp_len_t len) {
 	clear();
 
 	return addData(data, len);
@@ -107,65 +123,65 @@ bool SimplePacket::setData(const void *data, uint8_t len) {
 
 #if !defined(UNIVERSAL_CPP) && !defined(CUSTOM_TYPES)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(SP_BOOL data) {
+bool SimplePacketBase::addData(SP_BOOL data) {
 	return addData((unsigned char) data ? 0x01 : 0x00);
 }
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(SP_CHAR data) {
-	return addData(&data, sizeof(data));
+bool SimplePacketBase::addData(SP_CHAR data) {
+	return addValue(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(SP_UCHAR data) {
-	return addData(&data, sizeof(data));
+bool SimplePacketBase::addData(SP_UCHAR data) {
+	return addValue(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(SP_INT data) {
-	return addData(&data, sizeof(data));
+bool SimplePacketBase::addData(SP_INT data) {
+	return addValue(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(SP_UINT data) {
-	return addData(&data, sizeof(data));
+bool SimplePacketBase::addData(SP_UINT data) {
+	return addValue(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(SP_LONG data) {
-	return addData(&data, sizeof(data));
+bool SimplePacketBase::addData(SP_LONG data) {
+	return addValue(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(SP_ULONG data) {
-	return addData(&data, sizeof(data));
+bool SimplePacketBase::addData(SP_ULONG data) {
+	return addValue(data);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(SP_DOUBLE data) {
-	return addData(&data, sizeof(data));
+bool SimplePacketBase::addData(SP_DOUBLE data) {
+	return addValue(data);
 }
 
 #ifdef SP_STRING_TYPE
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(const String &data) {
+bool SimplePacketBase::addData(const String &data) {
 	return addData(data.c_str(), data.length() + 1);
 }
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(const char *data) {
+bool SimplePacketBase::addData(const char *data) {
 	return addData(data, strlen(data) + 1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(const __FlashStringHelper* data) {
-	return addData(data, SP_MAX_DATA_LEN - _dataLen);
+bool SimplePacketBase::addData(const __FlashStringHelper* data) {
+	return addData(data, _capacity - _dataLen);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(const __FlashStringHelper* data, uint8_t expectedLength) {
+bool SimplePacketBase::addData(const __FlashStringHelper* data, sp_len_t expectedLength) {
 	char buffer[expectedLength + 1 - _dataLen];
 	strncpy_P(buffer, (const char*) data, expectedLength - _dataLen);
 	buffer[expectedLength - _dataLen] = '\0';
@@ -173,14 +189,17 @@ bool SimplePacket::addData(const __FlashStringHelper* data, uint8_t expectedLeng
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::addData(const void *data, uint8_t len) {
-	if (((uint16_t) _dataLen + len) > SP_MAX_DATA_LEN) {
+bool SimplePacketBase::addData(const void *data, sp_len_t len) {
+	if (((uint32_t) _dataLen + len) > _capacity) {
 		return false;
 	}
 
 	else if (len > 0) {
-		memcpy(_buff.data + _dataLen, data, len);
+		memcpy(buffer()->data + _dataLen, data, len);
 		_dataLen += len;
+#if SP_CRC_MODE == SP_CRC_SUM
+		_crc = SimpleCRC::update(_crc, (const uint8_t *) data, len);
+#endif
 	}
 
 	return true;
@@ -188,124 +207,125 @@ bool SimplePacket::addData(const void *data, uint8_t len) {
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-bool SimplePacket::getBool() const {
-	if (!_buff.data) {
-		return false;
-	}
-
-	return *(SP_BOOL *) _buff.data;
+bool SimplePacketBase::addVarUInt(uint32_t data) {
+	uint8_t buffer[SimpleWire::VARINT_MAX_LEN];
+	return addData(buffer, SimpleWire::putVarint(buffer, data));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-char SimplePacket::getChar() const {
-	if (!_buff.data) {
-		return '\0';
-	}
-
-	return *(SP_CHAR *) _buff.data;
+bool SimplePacketBase::addVarInt(int32_t data) {
+	return addVarUInt(SimpleWire::zigzag(data));
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-unsigned char SimplePacket::getUChar() const {
-	if (!_buff.data) {
-		return '\0';
-	}
-
-	return *(SP_UCHAR *) _buff.data;
+bool SimplePacketBase::getBool() const {
+	return getFirst<SP_BOOL>();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-int SimplePacket::getInt() const {
-	if (!_buff.data) {
-		return 0;
-	}
-
-	return *(SP_INT *) _buff.data;
+char SimplePacketBase::getChar() const {
+	return getFirst<SP_CHAR>();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-unsigned int SimplePacket::getUInt() const {
-	if (!_buff.data) {
-		return 0;
-	}
-
-	return *(SP_UINT *) _buff.data;
+unsigned char SimplePacketBase::getUChar() const {
+	return getFirst<SP_UCHAR>();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-long SimplePacket::getLong() const {
-	if (!_buff.data) {
-		return 0L;
-	}
-
-	return *(SP_LONG *) _buff.data;
+int SimplePacketBase::getInt() const {
+	return getFirst<SP_INT>();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-unsigned long SimplePacket::getULong() const {
-	if (!_buff.data) {
-		return 0UL;
-	}
+unsigned int SimplePacketBase::getUInt() const {
+	return getFirst<SP_UINT>();
+}
 
-	return *(SP_ULONG *) _buff.data;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+long SimplePacketBase::getLong() const {
+	return getFirst<SP_LONG>();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-double SimplePacket::getDouble() const {
-	if (!_buff.data) {
-		return 0.0L;
-	}
+unsigned long SimplePacketBase::getULong() const {
+	return getFirst<SP_ULONG>();
+}
 
-	return *(SP_DOUBLE *) _buff.data;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+double SimplePacketBase::getDouble() const {
+	return getFirst<SP_DOUBLE>();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-const char *SimplePacket::getString() const {
-	return (const char *) _buff.data;
+const char *SimplePacketBase::getString() const {
+	return (const char *) buffer()->data;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-const void *SimplePacket::getData() const {
-	return _buff.data;
+const void *SimplePacketBase::getData() const {
+	return buffer()->data;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-const void *SimplePacket::getData(uint8_t &len) const {
+const void *SimplePacketBase::getData(sp_len_t &len) const {
 	len = getDataLength();
-	return _buff.data;
+	return buffer()->data;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimplePacket::setSource(uint8_t source) {
-	_buff.source = source;
+void SimplePacketBase::setSource(uint8_t source) {
+	buffer()->source = source;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimplePacket::setDestination(uint8_t destination) {
-	_buff.destination = destination;
+void SimplePacketBase::setDestination(uint8_t destination) {
+	buffer()->destination = destination;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SimplePacket::setType(uint8_t type) {
-	_buff.type = type;
+void SimplePacketBase::setType(uint8_t type) {
+	buffer()->type = type;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-uint8_t SimplePacket::getSource() const {
-	return _buff.source;
+uint8_t SimplePacketBase::getSource() const {
+	return buffer()->source;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-uint8_t SimplePacket::getDestination() const {
-	return _buff.destination;
+uint8_t SimplePacketBase::getDestination() const {
+	return buffer()->destination;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-uint8_t SimplePacket::getType() const {
-	return _buff.type;
+uint8_t SimplePacketBase::getType() const {
+	return buffer()->type;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-uint8_t SimplePacket::getDataLength() const {
+sp_len_t SimplePacketBase::getDataLength() const {
 	return _dataLen;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_len_t SimplePacketBase::getCapacity() const {
+	return _capacity;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimplePacketBase::copyFrom(const SimplePacketBase &packet) {
+	if (&packet == this) {
+		return true;
+	}
+	if (packet._dataLen > _capacity) {
+		return false;
+	}
+
+	// The frame of a received packet comes along, up to its CRC
+	memcpy(buffer(), packet.buffer(), sizeof(SimplePacketBuffer) + packet._dataLen + SP_CRC_LEN);
+	_dataLen = packet._dataLen;
+	_crc = packet._crc;
+	_exhausted = packet._exhausted;
+	return true;
+}
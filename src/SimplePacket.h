@@ -2,6 +2,8 @@
 #define __SimplePacket_H__
 
 #include "SimplePacketConfig.h"
+#include "SimpleCRC.h"
+#include "SimpleWire.h"
 
 
 // PACKET FORMAT:
@@ -13,9 +15,16 @@
 // |   SYN   |   LEN   |            HDR              |   DAT   |   CRC   |
 // |_________|_________|_____________________________|_________|_________|
 // |         |         |         |         |         |         |         |
-// | SYN (1) | LEN (1) | DST (1) | SRC (1) | TYP (1) |   DAT   | CRC (1) |
+// | SYN (1) | LEN (1) | DST (1) | SRC (1) | TYP (1) |   DAT   | CRC (*) |
 // |_________|_________|_________|_________|_________|_________|_________|
 //
+// (*) 1 byte, or 2 bytes (low byte first) with SP_CRC_16_MODBUS
+//
+// Long frames (SYN flagged with SP_SYN_LONG) put the high byte of a 16-bit
+// LEN between SYN and LEN:
+//
+// | SYN (1) | LEN high (1) | LEN (1) | DST (1) | ... | CRC (*) |
+//
 
 #define SP_SYN_LEN 1
 #define SP_LEN_LEN 1
@@ -23,25 +32,93 @@
 #define SP_SRC_LEN 1
 #define SP_TYP_LEN 1
 #define SP_HDR_LEN (SP_DST_LEN + SP_SRC_LEN + SP_TYP_LEN)
-#define SP_MAX_DATA_LEN 128
+#if SP_CRC_MODE == SP_CRC_16_MODBUS
+#define SP_CRC_LEN 2
+#else
 #define SP_CRC_LEN 1
+#endif
+
+#ifndef SP_MAX_DATA_LEN
+#define SP_MAX_DATA_LEN 128
+#endif
+
+// Longest payload of a frame with a 1-byte LEN
+#define SP_SHORT_MAX_DATA_LEN (0xFF - SP_HDR_LEN - SP_CRC_LEN)
+
+// Whole frames, not only LEN, must fit in 16 bits
+#if SP_MAX_DATA_LEN > 0xFFFF - (SP_SYN_LEN + 2 * SP_LEN_LEN + SP_HDR_LEN + SP_CRC_LEN)
+#error "SP_MAX_DATA_LEN is too large for a 16-bit LEN"
+#elif SP_MAX_DATA_LEN > SP_SHORT_MAX_DATA_LEN
+#define SP_LONG_FRAMES
+#define SP_LEN_EXT_LEN 1
+#else
+#define SP_LEN_EXT_LEN 0
+#endif
 
 #define SP_SYN_VALUE 0x02
 
+// Flags carried in the high bits of the SYN byte, and the ones this build
+// understands
+#define SP_SYN_COMPRESSED 0x10
+#define SP_SYN_LONG 0x20
+#ifdef SP_COMPRESSION
+#define SP_SYN_COMPRESSED_FLAG SP_SYN_COMPRESSED
+#else
+#define SP_SYN_COMPRESSED_FLAG 0
+#endif
+#ifdef SP_LONG_FRAMES
+#define SP_SYN_LONG_FLAG SP_SYN_LONG
+#else
+#define SP_SYN_LONG_FLAG 0
+#endif
+#define SP_SYN_FLAGS (SP_SYN_COMPRESSED_FLAG | SP_SYN_LONG_FLAG)
+
 #define SP_BUFFER_SIZE (SP_SYN_LEN +		\
+			SP_LEN_EXT_LEN +	\
 			SP_LEN_LEN +		\
 			SP_HDR_LEN +		\
 			SP_MAX_DATA_LEN +	\
 			SP_CRC_LEN)
 
+// Lengths of whole frames: the longest classic frames, SYN and LEN
+// included, don't fit in 8 bits either
+#if SP_BUFFER_SIZE > 0xFF
+typedef uint16_t sp_len_t;
+#else
+typedef uint8_t sp_len_t;
+#endif
+
 #define SP_BUFF_READ_OFFSET (SP_SYN_LEN + SP_LEN_LEN + SP_HDR_LEN)
 
 
-class SimplePacket {
+// Frame held by a packet, in place: SYN and LEN go in front of the header
+// and the CRC after the data, so frames are sent from and received into
+// packets without copies
+typedef struct {
+#ifdef SP_LONG_FRAMES
+	// SYN of long frames, whose LEN high byte takes the place of the
+	// SYN of the others: the header is in place in both
+	uint8_t lead;
+#endif
+	uint8_t syn;
+	uint8_t expectedLen;
+	uint8_t destination;
+	uint8_t source;
+	uint8_t type;
+	uint8_t data[];
+} SimplePacketBuffer;
+
+// Code of the packets, whatever their capacity. Packets are declared as
+// SimplePacket (SP_MAX_DATA_LEN bytes of payload) or BasicSimplePacket<N>,
+// and passed around as SimplePacketBase.
+class SimplePacketBase {
 public:
 	friend class SimpleCommClass;
-
-	explicit SimplePacket();
+	friend class SimpleCommLink;
+	friend class SimpleCommTxQueue;
+	friend class SimpleCommBatch;
+	friend class SimpleCommReliable;
+	template <typename... Fields> friend class SimpleMessage;
 
 	// Packet functions
 	void clear();
@@ -69,8 +146,8 @@ public:
 #endif
 	bool setData(const char *data);
 	bool setData(const __FlashStringHelper* data);
-	bool setData(const __FlashStringHelper* data, uint8_t expectedLength);
-	bool setData(const void *data, uint8_t len);
+	bool setData(const __FlashStringHelper* data, sp_len_t expectedLength);
+	bool setData(const void *data, sp_len_t len);
 
 	#if !defined(UNIVERSAL_CPP) && !defined(CUSTOM_TYPES)
 	bool addData(SP_BOOL data);
@@ -87,8 +164,13 @@ public:
 #endif
 	bool addData(const char *data);
 	bool addData(const __FlashStringHelper* data);
-	bool addData(const __FlashStringHelper* data, uint8_t expectedLength);
-	bool addData(const void *data, uint8_t len);
+	bool addData(const __FlashStringHelper* data, sp_len_t expectedLength);
+	bool addData(const void *data, sp_len_t len);
+
+	// Variable length integers (see SimpleWire::putVarint()), read back with
+	// SimplePacketReader::readVarUInt()/readVarInt()
+	bool addVarUInt(uint32_t data);
+	bool addVarInt(int32_t data);
 
 	bool getBool() const;
 	char getChar() const;
@@ -100,21 +182,119 @@ public:
 	double getDouble() const;
 	const char *getString() const;
 	const void *getData() const;
-	const void *getData(uint8_t &len) const;
+	const void *getData(sp_len_t &len) const;
+
+	sp_len_t getDataLength() const;
 
-	uint8_t getDataLength() const;
+	// Longest payload the packet can hold
+	sp_len_t getCapacity() const;
+
+	// Copies the header and the payload of another packet, of any capacity.
+	// Returns false, leaving the packet untouched, when they don't fit.
+	bool copyFrom(const SimplePacketBase &packet);
+
+protected:
+	explicit SimplePacketBase(sp_len_t capacity);
+
+	// Buffer of the packet, in the derived class
+	void attach(uint8_t *storage);
+
+	// Copies everything but the buffer pointer, which is attached again
+	SimplePacketBase(const SimplePacketBase &packet) = default;
+	SimplePacketBase &operator=(const SimplePacketBase &packet) = default;
 
 private:
-        struct {
-		uint8_t syn;
-		uint8_t expectedLen;
-		uint8_t destination;
-		uint8_t source;
-		uint8_t type;
-		uint8_t data[SP_MAX_DATA_LEN + SP_CRC_LEN];
-	} _buff;
-	uint8_t _dataLen;
-	uint8_t _exhausted;
+	SimplePacketBuffer *buffer() {
+		return (SimplePacketBuffer*) _buffer;
+	}
+	const SimplePacketBuffer *buffer() const {
+		return (const SimplePacketBuffer*) _buffer;
+	}
+
+	// Bytes of the buffer holding the header, the payload and its CRC
+	sp_len_t bufferSize() const {
+		return sizeof(SimplePacketBuffer) + _capacity + SP_CRC_LEN;
+	}
+
+	// Scalar added with the encoding of SimpleWire::store()
+	template <typename T>
+	bool addValue(const T &value) {
+		uint8_t buffer[SimpleWire::Stored<T>::size];
+		SimpleWire::store(buffer, value);
+		return addData(buffer, sizeof(buffer));
+	}
+
+	// First field of the payload, or 0 if it's shorter. The data may not
+	// be aligned for T: SimpleWire::load() copies it.
+	template <typename T>
+	T getFirst() const {
+		T value = T();
+		if (_dataLen >= SimpleWire::Stored<T>::size) {
+			SimpleWire::load(buffer()->data, value);
+		}
+		return value;
+	}
+
+private:
+	sp_len_t _dataLen;
+	sp_len_t _capacity;
+
+	// Running sum of DAT, kept by addData() when the check is the (order
+	// independent) SP_CRC_SUM
+	sp_crc_t _crc;
+
+	// Returned by SimpleComm.receive(), which clears it on the next call
+	bool _exhausted;
+
+	uint8_t *_buffer;
+};
+
+// Packet with room for N bytes of payload. Most messages are a few bytes
+// long: on small CPUs, queues and caches of short packets take a fraction
+// of the RAM of full ones. Frames with longer payloads are received as
+// invalid lengths.
+template <sp_len_t N>
+class BasicSimplePacket : public SimplePacketBase {
+public:
+	static_assert(N <= SP_MAX_DATA_LEN, "Packet capacity bigger than SP_MAX_DATA_LEN");
+
+	explicit BasicSimplePacket() : SimplePacketBase(N) {
+		attach(_storage);
+		memset(_storage, 0, sizeof(_storage));
+	}
+
+	BasicSimplePacket(const BasicSimplePacket &packet) : SimplePacketBase(packet) {
+		attach(_storage);
+		memcpy(_storage, packet._storage, sizeof(_storage));
+	}
+	BasicSimplePacket &operator=(const BasicSimplePacket &packet) {
+		if (&packet != this) {
+			SimplePacketBase::operator=(packet);
+			attach(_storage);
+			memcpy(_storage, packet._storage, sizeof(_storage));
+		}
+		return *this;
+	}
+
+	// From packets of other capacities. A payload that doesn't fit leaves
+	// the packet empty.
+	BasicSimplePacket(const SimplePacketBase &packet) : SimplePacketBase(N) {
+		attach(_storage);
+		memset(_storage, 0, sizeof(_storage));
+		copyFrom(packet);
+	}
+	BasicSimplePacket &operator=(const SimplePacketBase &packet) {
+		if (!copyFrom(packet)) {
+			clear();
+		}
+		return *this;
+	}
+
+private:
+	uint8_t _storage[sizeof(SimplePacketBuffer) + N + SP_CRC_LEN];
 };
 
+// Packet with room for the longest payload
+typedef BasicSimplePacket<SP_MAX_DATA_LEN> SimplePacket;
+
 #endif // __SimplePacket_H__
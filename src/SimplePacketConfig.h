@@ -12,6 +12,19 @@ want to communicate CPUs with different architectures. */
 what you define. */
 //#define CUSTOM_TYPES
 
+/* When the SP_WIRE_FORMAT macro is enabled, values are sent with a fixed
+width and in little-endian byte order whatever the CPU, so AVR, ARM and
+Linux devices understand each other without conversions. It implies
+UNIVERSAL_CPP, unless CUSTOM_TYPES is enabled. SP_DOUBLE is sent as an
+IEEE float32, or as an IEEE float64 when SP_WIRE_DOUBLE64 is enabled too
+(converted in software where double is 32 bits wide, e.g. AVR). */
+//#define SP_WIRE_FORMAT
+//#define SP_WIRE_DOUBLE64
+
+#if defined(SP_WIRE_FORMAT) && !defined(UNIVERSAL_CPP) && !defined(CUSTOM_TYPES)
+#define UNIVERSAL_CPP
+#endif
+
 #if defined(UNIVERSAL_CPP)
 #define SP_BOOL uint8_t
 #define SP_CHAR char
@@ -44,4 +57,61 @@ what you define. */
 
 #endif
 
+#if defined(SP_WIRE_FORMAT) && defined(SP_WIRE_DOUBLE64)
+#undef SP_DOUBLE
+#define SP_DOUBLE double
+#endif
+
+/* Integrity check appended to every packet. Both ends must be built with
+the same one:
+ - SP_CRC_SUM: 8-bit additive checksum, compatible with previous versions
+ - SP_CRC_8: CRC-8 (polynomial 0x07), table in PROGMEM
+ - SP_CRC_16_MODBUS: CRC-16/MODBUS (polynomial 0x8005 reflected, initial
+   value 0xFFFF), table in PROGMEM, sent low byte first */
+#define SP_CRC_SUM 0
+#define SP_CRC_8 1
+#define SP_CRC_16_MODBUS 2
+
+#ifndef SP_CRC_MODE
+#define SP_CRC_MODE SP_CRC_SUM
+#endif
+
+/* When the SP_CRC_SLICE_BY_4 macro is enabled, CRC-8 and CRC-16 process 4
+bytes per step using tables built in RAM on first use (1 KB for CRC-8,
+2 KB for CRC-16). Only for CPUs with enough RAM. */
+//#define SP_CRC_SLICE_BY_4
+
+/* When the SP_COMPRESSION macro is enabled, links can compress large
+payloads (see SimpleCommLink::setCompression()) and decompress the
+compressed frames they receive. Those frames are flagged in the SYN byte:
+devices built without SP_COMPRESSION drop them. */
+//#define SP_COMPRESSION
+
+/* Longest payload of a packet, 128 bytes by default. Above 251 bytes (250
+with SP_CRC_16_MODBUS) the LEN field no longer fits in one byte: the larger
+payloads are sent in long frames, flagged in the SYN byte and with a second
+LEN byte. Shorter payloads keep the classic frame, so devices built without
+long frames still understand them. */
+//#define SP_MAX_DATA_LEN 1024
+
+/* Link statistics (SimpleCommLink::getStats()). They are enabled unless
+SP_STATS is defined to 0, which compiles the counters out: getStats() then
+returns zeros. When the SP_STATS_LATENCY macro is enabled too, the links
+keep a histogram of the time spent in receive() by the calls that read
+bytes, measured with their clock. */
+#ifndef SP_STATS
+#define SP_STATS 1
+#endif
+//#define SP_STATS_LATENCY
+
+/* Bounds checks of SimplePacketReader. They are enabled unless NDEBUG is
+defined; define SP_READ_CHECKS to 0 or 1 to force them off or on. */
+#ifndef SP_READ_CHECKS
+#ifdef NDEBUG
+#define SP_READ_CHECKS 0
+#else
+#define SP_READ_CHECKS 1
+#endif
+#endif
+
 #endif  /* __SimplePacketConfig_H__ */
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimplePacketReader.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimplePacketReader::readVarUInt(uint32_t &value) {
+	// Bounded even without SP_READ_CHECKS: the end of a varint is only known once read
+	sp_len_t available = _len - _pos;
+	uint8_t len = SimpleWire::getVarint(_data + _pos, available < SimpleWire::VARINT_MAX_LEN ? available : SimpleWire::VARINT_MAX_LEN, value);
+	if (len == 0) {
+		_ok = false;
+		return false;
+	}
+
+	_pos += len;
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint32_t SimplePacketReader::readVarUInt() {
+	uint32_t value = 0;
+	readVarUInt(value);
+	return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int32_t SimplePacketReader::readVarInt() {
+	return SimpleWire::unzigzag(readVarUInt());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint8_t *SimplePacketReader::bytes(sp_len_t len) {
+	if (!check(len)) {
+		return NULL;
+	}
+
+	const uint8_t *ret = _data + _pos;
+	_pos += len;
+	return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SimplePacketReader SimplePacketReader::view(sp_len_t len) {
+	const uint8_t *data = bytes(len);
+	return SimplePacketReader(data, data ? len : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const char *SimplePacketReader::readString() {
+	const uint8_t *end = (const uint8_t *) memchr(_data + _pos, '\0', _len - _pos);
+	if (!end) {
+		_ok = false;
+		return NULL;
+	}
+
+	const char *ret = (const char *) _data + _pos;
+	_pos = end - _data + 1;
+	return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimplePacketReader::skip(sp_len_t len) {
+	return bytes(len) != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SimplePacketReader::rewind() {
+	_pos = 0;
+	_ok = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const uint8_t *SimplePacketReader::data() const {
+	return _data + _pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_len_t SimplePacketReader::size() const {
+	return _len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_len_t SimplePacketReader::position() const {
+	return _pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sp_len_t SimplePacketReader::remaining() const {
+	return _len - _pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SimplePacketReader::ok() const {
+	return _ok;
+}
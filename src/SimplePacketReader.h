@@ -0,0 +1,108 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimplePacketReader_H__
+#define __SimplePacketReader_H__
+
+#include "SimplePacket.h"
+
+
+// Cursor over the payload of a packet, reading fields in place:
+//
+//   SimplePacketReader reader(packet);
+//   int16_t temperature = reader.read<int16_t>();
+//   uint32_t timestamp = reader.read<uint32_t>();
+//   SimplePacketReader samples = reader.view(8);
+//
+// Reads going past the end of the payload return 0 and clear ok(). Those
+// bounds checks are compiled out when SP_READ_CHECKS is 0 (see
+// "SimplePacketConfig.h"); reads must then stay within the payload.
+class SimplePacketReader {
+public:
+	// Inline, so the cursor can live in registers
+	explicit SimplePacketReader(const SimplePacketBase &packet) : _pos(0), _ok(true) {
+		_data = (const uint8_t *) packet.getData(_len);
+	}
+
+	explicit SimplePacketReader(const void *data, sp_len_t len) : _data((const uint8_t *) data), _len(len), _pos(0), _ok(true) {
+	}
+
+	// Value at the cursor, which moves past it
+	template <typename T>
+	T read() {
+		T value = T();
+		read(value);
+		return value;
+	}
+
+	template <typename T>
+	bool read(T &value) {
+		if (!check(SimpleWire::Stored<T>::size)) {
+			return false;
+		}
+
+		// The field may not be aligned for T
+		SimpleWire::load(_data + _pos, value);
+		_pos += SimpleWire::Stored<T>::size;
+		return true;
+	}
+
+	// Variable length integers written by SimplePacket::addVarUInt()/addVarInt()
+	bool readVarUInt(uint32_t &value);
+	uint32_t readVarUInt();
+	int32_t readVarInt();
+
+	// The next len bytes, without copying them, and the cursor moves past them
+	const uint8_t *bytes(sp_len_t len);
+	SimplePacketReader view(sp_len_t len);
+
+	// NUL terminated string at the cursor, or NULL if it isn't terminated
+	// within the payload
+	const char *readString();
+
+	bool skip(sp_len_t len);
+	void rewind();
+
+	const uint8_t *data() const;
+	sp_len_t size() const;
+	sp_len_t position() const;
+	sp_len_t remaining() const;
+
+	// False once a read went past the end of the payload
+	bool ok() const;
+
+private:
+	bool check(sp_len_t len) {
+#if SP_READ_CHECKS
+		if (len > _len - _pos) {
+			_ok = false;
+			return false;
+		}
+#else
+		(void) len;
+#endif
+		return true;
+	}
+
+private:
+	const uint8_t *_data;
+	sp_len_t _len;
+	sp_len_t _pos;
+	bool _ok;
+};
+
+#endif // __SimplePacketReader_H__
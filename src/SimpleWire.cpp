@@ -0,0 +1,119 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimpleWire.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleWire::putVarint(uint8_t *buffer, uint32_t value) {
+	uint8_t len = 0;
+	while (value >= 0x80) {
+		buffer[len++] = (value & 0x7F) | 0x80;
+		value >>= 7;
+	}
+	buffer[len++] = value;
+	return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint8_t SimpleWire::getVarint(const uint8_t *buffer, uint8_t len, uint32_t &value) {
+	if (len > VARINT_MAX_LEN) {
+		len = VARINT_MAX_LEN;
+	}
+
+	uint32_t ret = 0;
+	for (uint8_t i = 0; i < len; ++i) {
+		ret |= (uint32_t) (buffer[i] & 0x7F) << (7 * i);
+		if (!(buffer[i] & 0x80)) {
+			value = ret;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t SimpleWire::float64Bits(float value) {
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	uint64_t sign = (uint64_t) (bits >> 31) << 63;
+	int16_t exponent = (bits >> 23) & 0xFF;
+	uint32_t mantissa = bits & 0x7FFFFF;
+
+	if (exponent == 0xFF) {
+		// Infinity and NaN
+		return sign | (0x7FFULL << 52) | ((uint64_t) mantissa << 29);
+	}
+	if (exponent == 0) {
+		if (mantissa == 0) {
+			return sign;
+		}
+
+		// Subnormal float32: normal float64
+		exponent = 1;
+		while (!(mantissa & 0x800000)) {
+			mantissa <<= 1;
+			--exponent;
+		}
+		mantissa &= 0x7FFFFF;
+	}
+
+	return sign | ((uint64_t) (exponent - 127 + 1023) << 52) | ((uint64_t) mantissa << 29);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+float SimpleWire::fromFloat64Bits(uint64_t bits) {
+	uint32_t sign = (uint32_t) (bits >> 63) << 31;
+	int16_t exponent = (bits >> 52) & 0x7FF;
+	uint64_t mantissa = bits & 0xFFFFFFFFFFFFFULL;
+
+	uint32_t ret;
+	if (exponent == 0x7FF) {
+		// Infinity and NaN, which stays a NaN
+		ret = sign | 0x7F800000UL | (mantissa ? 0x400000UL | (uint32_t) (mantissa >> 29) : 0);
+	}
+	else if (exponent - 1023 + 127 >= 0xFF) {
+		ret = sign | 0x7F800000UL;
+	}
+	else if (exponent - 1023 + 127 < -23) {
+		// Below half of the smallest subnormal float32
+		ret = sign;
+	}
+	else {
+		exponent = exponent - 1023 + 127;
+		uint8_t shift = 29;
+		if (exponent <= 0) {
+			// Subnormal float32: the implicit bit becomes explicit
+			mantissa |= 1ULL << 52;
+			shift += 1 - exponent;
+			exponent = 0;
+		}
+
+		// Round to nearest even; a carry moves to the exponent, up to infinity
+		uint32_t m = mantissa >> shift;
+		uint64_t rest = mantissa & ((1ULL << shift) - 1);
+		uint64_t half = 1ULL << (shift - 1);
+		if (rest > half || (rest == half && (m & 1))) {
+			++m;
+		}
+		ret = sign | (((uint32_t) exponent << 23) + m);
+	}
+
+	float value;
+	memcpy(&value, &ret, sizeof(value));
+	return value;
+}
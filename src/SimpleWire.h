@@ -0,0 +1,193 @@
+/*
+   Copyright (c) 2026 Boot&Work Corp., S.L. All rights reserved
+
+   This library is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SimpleWire_H__
+#define __SimpleWire_H__
+
+#include "SimplePacketConfig.h"
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define SP_BIG_ENDIAN_HOST
+#endif
+
+
+// Fixed width, little-endian encoding of scalar values. Byte swaps only
+// exist on big-endian CPUs: on the others, put() and get() are plain
+// copies. float is sent as an IEEE float32 and double as an IEEE float64.
+class SimpleWire {
+public:
+	// Arithmetic types are encoded, the others are copied as they are
+	template <typename T>
+	struct Scalar {
+		static const bool value = false;
+	};
+
+	// Size of a value on the wire
+	template <typename T>
+	struct Size {
+		static const uint8_t value = sizeof(T);
+	};
+
+	static uint16_t swap(uint16_t value) {
+		return __builtin_bswap16(value);
+	}
+	static uint32_t swap(uint32_t value) {
+		return __builtin_bswap32(value);
+	}
+	static uint64_t swap(uint64_t value) {
+		return __builtin_bswap64(value);
+	}
+
+	template <typename T>
+	static void put(uint8_t *buffer, const T &value) {
+		Bits<sizeof(T), Scalar<T>::value>::put(buffer, &value);
+	}
+
+	template <typename T>
+	static void get(const uint8_t *buffer, T &value) {
+		Bits<sizeof(T), Scalar<T>::value>::get(buffer, &value);
+	}
+
+	// Variable length integers (LEB128): 7 bits per byte, low bits first,
+	// the highest bit set on every byte but the last. Up to 5 bytes.
+	static const uint8_t VARINT_MAX_LEN = 5;
+	static uint8_t putVarint(uint8_t *buffer, uint32_t value);
+	// Returns the number of bytes read, 0 if the varint doesn't end within len
+	static uint8_t getVarint(const uint8_t *buffer, uint8_t len, uint32_t &value);
+
+	// Signed values mapped to unsigned ones so that small negative values
+	// stay short as varints: 0, -1, 1, -2... become 0, 1, 2, 3...
+	static uint32_t zigzag(int32_t value) {
+		return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+	}
+	static int32_t unzigzag(uint32_t value) {
+		return (int32_t) ((value >> 1) ^ (0 - (value & 1)));
+	}
+
+	// IEEE float64 bits of a float32 and back, for CPUs whose double is 32
+	// bits wide. Rounds to nearest even.
+	static uint64_t float64Bits(float value);
+	static float fromFloat64Bits(uint64_t bits);
+
+	// Encoding used for the payload of the packets: the wire format above
+	// with SP_WIRE_FORMAT, the native layout of the CPU without it
+	template <typename T>
+	struct Stored {
+#ifdef SP_WIRE_FORMAT
+		static const uint8_t size = Size<T>::value;
+#else
+		static const uint8_t size = sizeof(T);
+#endif
+	};
+
+	template <typename T>
+	static void store(uint8_t *buffer, const T &value) {
+#ifdef SP_WIRE_FORMAT
+		put(buffer, value);
+#else
+		memcpy(buffer, &value, sizeof(T));
+#endif
+	}
+
+	template <typename T>
+	static void load(const uint8_t *buffer, T &value) {
+#ifdef SP_WIRE_FORMAT
+		get(buffer, value);
+#else
+		memcpy(&value, buffer, sizeof(T));
+#endif
+	}
+
+private:
+	// Copy of N bytes, swapped to little-endian order for scalars
+	template <uint8_t N, bool SCALAR>
+	struct Bits {
+		static void put(uint8_t *buffer, const void *value) {
+			memcpy(buffer, value, N);
+		}
+		static void get(const uint8_t *buffer, void *value) {
+			memcpy(value, buffer, N);
+		}
+	};
+};
+
+#define SP_WIRE_SCALAR(TYPE)								\
+	template <>									\
+	struct SimpleWire::Scalar<TYPE> {						\
+		static const bool value = true;						\
+	};
+SP_WIRE_SCALAR(bool)
+SP_WIRE_SCALAR(char)
+SP_WIRE_SCALAR(signed char)
+SP_WIRE_SCALAR(unsigned char)
+SP_WIRE_SCALAR(short)
+SP_WIRE_SCALAR(unsigned short)
+SP_WIRE_SCALAR(int)
+SP_WIRE_SCALAR(unsigned int)
+SP_WIRE_SCALAR(long)
+SP_WIRE_SCALAR(unsigned long)
+SP_WIRE_SCALAR(long long)
+SP_WIRE_SCALAR(unsigned long long)
+SP_WIRE_SCALAR(float)
+SP_WIRE_SCALAR(double)
+#undef SP_WIRE_SCALAR
+
+#ifdef SP_BIG_ENDIAN_HOST
+#define SP_WIRE_BITS(N, TYPE)								\
+	template <>									\
+	struct SimpleWire::Bits<N, true> {						\
+		static void put(uint8_t *buffer, const void *value) {			\
+			TYPE bits;							\
+			memcpy(&bits, value, N);					\
+			bits = SimpleWire::swap(bits);					\
+			memcpy(buffer, &bits, N);					\
+		}									\
+		static void get(const uint8_t *buffer, void *value) {			\
+			TYPE bits;							\
+			memcpy(&bits, buffer, N);					\
+			bits = SimpleWire::swap(bits);					\
+			memcpy(value, &bits, N);					\
+		}									\
+	};
+SP_WIRE_BITS(2, uint16_t)
+SP_WIRE_BITS(4, uint32_t)
+SP_WIRE_BITS(8, uint64_t)
+#undef SP_WIRE_BITS
+#endif
+
+#if __SIZEOF_DOUBLE__ == 4
+// double is a float32 on this CPU: it goes on the wire as a float64
+template <>
+struct SimpleWire::Size<double> {
+	static const uint8_t value = 8;
+};
+
+template <>
+inline void SimpleWire::put<double>(uint8_t *buffer, const double &value) {
+	uint64_t bits = float64Bits(value);
+	put(buffer, bits);
+}
+
+template <>
+inline void SimpleWire::get<double>(const uint8_t *buffer, double &value) {
+	uint64_t bits;
+	get(buffer, bits);
+	value = fromFloat64Bits(bits);
+}
+#endif
+
+#endif // __SimpleWire_H__